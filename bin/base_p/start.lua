@@ -24,7 +24,10 @@ GUI:LoadLayers("Layers.xml")
 
 --
 -- Фактическая загрузка группы ресурсов: создаются объекты текстур, загружаются
--- изображения с диска и т.п. Это длительная операция.
+-- изображения с диска и т.п. Здесь загружаются только шрифт, звуки и фон.
+-- Текстуры с upload="false" загружает ShooterWidget в фоновых потоках,
+-- показывая экран загрузки, а экраны победы и поражения из группы WarLateGroup
+-- догружаются во время игры.
 --
 UploadResourceGroup("WarGroup")
 
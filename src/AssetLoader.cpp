@@ -0,0 +1,116 @@
+/**
+ * \file
+ * \brief Implementation of the loader of the textures
+ * \author Maksimovskiy A.S.
+ */
+
+#include "stdafx.h"
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include "AssetLoader.h"
+#include "ClassHelpers.h"
+#include "sim/XmlTags.h"
+
+namespace
+{
+    // Names of the groups of Resources.xml in the order of AssetGroup
+    const char* const GROUP_NAMES[] = { "WarGroup", "WarLateGroup" };
+
+    // The main thread and the simulation thread keep their cores
+    const size_t MAX_THREADS = 4;
+
+    size_t ThreadCount()
+    {
+        size_t cores = std::thread::hardware_concurrency();
+        return std::max<size_t>(1, std::min(MAX_THREADS, cores > 2 ? cores - 2 : 1));
+    }
+
+    // Reading the image file, so the engine decodes it from the cache of the system without waiting for the disk
+    bool ReadImage(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        const unsigned char PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        std::vector<char> buffer(64 * 1024);
+        file.read(buffer.data(), buffer.size());
+        if (file.gcount() < static_cast<std::streamsize>(sizeof(PNG_SIGNATURE)) ||
+            !std::equal(PNG_SIGNATURE, PNG_SIGNATURE + sizeof(PNG_SIGNATURE), reinterpret_cast<unsigned char*>(buffer.data())))
+            return false;
+
+        while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+        {
+        }
+        return true;
+    }
+}
+
+AssetLoader::AssetLoader() :
+    mQueue(ThreadCount())
+{
+}
+
+void AssetLoader::SetProgress(ProgressFunc progress)
+{
+    mQueue.SetProgress([progress](int group, size_t done, size_t total, const std::string& id)
+    {
+        progress(static_cast<AssetGroup>(group), static_cast<float>(done) / total, id);
+    });
+}
+
+void AssetLoader::Start()
+{
+    IO::InputStreamPtr stream = Core::fileSystem.OpenRead("Resources.xml");
+    if (!stream)
+        throw std::runtime_error(std::string("Can't open file: Resources.xml"));
+
+    std::vector<uint8_t> buffer;
+    if (!stream->ReadAllBytes(buffer))
+        throw std::runtime_error(std::string("Can't read file: Resources.xml"));
+
+    std::vector<std::string> errors;
+    auto tags = sim::FindTags(std::string(buffer.begin(), buffer.end()), "texture", errors);
+    if (!errors.empty())
+        throw std::runtime_error("Resources.xml: " + boost::algorithm::join(errors, "; "));
+
+    // The textures uploaded by UploadResourceGroup are already loaded
+    for (auto& tag : tags)
+    {
+        if (sim::TagAttribute(tag, "upload") != "false")
+            continue;
+
+        std::string group_name = sim::TagAttribute(tag, "group");
+        auto group = std::find(std::begin(GROUP_NAMES), std::end(GROUP_NAMES), group_name);
+        if (group == std::end(GROUP_NAMES))
+            continue;
+
+        std::string id = sim::TagAttribute(tag, "id");
+        std::string path = IO::Path::Combine(object_params::BaseDirectory(), sim::TagAttribute(tag, "path") + ".png");
+        mQueue.Add(static_cast<int>(group - std::begin(GROUP_NAMES)), id,
+            [path]()
+            {
+                return ReadImage(path);
+            },
+            [id](bool)
+            {
+                // The engine reports the texture it can't load itself
+                Render::Texture* texture = Core::resourceManager.Get<Render::Texture>(id);
+                if (texture)
+                    texture->Upload();
+            });
+    }
+}
+
+bool AssetLoader::Update(double budget)
+{
+    return mQueue.Poll(budget);
+}
+
+void AssetLoader::Require(const std::string& id)
+{
+    mQueue.Require(id);
+}
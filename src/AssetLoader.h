@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Loading of the textures of Resources.xml on the worker threads
+ * \author Maksimovskiy A.S.
+ */
+
+#include <functional>
+
+#include "sim/LoadQueue.h"
+
+// Groups of the textures loaded by the loader
+enum class AssetGroup
+{
+    // Textures of the round, the game waits for them on the loading screen
+    WAR,
+    // Rarely used textures loaded in the background during the round
+    LATE,
+    COUNT
+};
+
+// Textures of Resources.xml with upload="false" which the engine would otherwise upload on their first drawing.
+// The workers read the files of the textures, the main thread uploads them within the time budget of the frame,
+// so the frames are drawn during the loading and the round doesn't stop on a new texture.
+class AssetLoader
+{
+public:
+    // Progress of the group: share of its loaded textures and the id of the last loaded one
+    using ProgressFunc = std::function<void(AssetGroup group, float progress, const std::string& id)>;
+
+    AssetLoader();
+
+    // Function called on the main thread after each loaded texture
+    void SetProgress(ProgressFunc progress);
+
+    // Adding the textures of Resources.xml to the queue
+    void Start();
+
+    // Uploading the read textures during at most budget seconds. Returns true if all textures are loaded.
+    bool Update(double budget);
+
+    // Uploading the texture at once if it isn't loaded yet
+    void Require(const std::string& id);
+
+    bool Done(AssetGroup group) const { return mQueue.GroupDone(static_cast<int>(group)); }
+
+    // Textures whose files couldn't be read
+    size_t Errors() const { return mQueue.Errors(); }
+private:
+    sim::LoadQueue mQueue;
+};
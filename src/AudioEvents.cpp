@@ -0,0 +1,108 @@
+/**
+ * \file
+ * \brief Implementation of the sounds and music of the game
+ * \author Maksimovskiy A.S.
+ */
+
+#include "stdafx.h"
+
+#include "AudioEvents.h"
+
+namespace
+{
+    // Names of the samples of Resources.xml in the order of SoundEvent and MusicTrack.
+    // They are made once, so the calls of the engine don't build the strings.
+    const std::string SOUND_NAMES[] = { "ShotSound", "RechargeSound" };
+    const std::string TRACK_NAMES[] = { "", "MainTheme", "WinTheme", "LoseTheme" };
+
+    // Time of the crossfade of the tracks in seconds
+    const float TRACK_FADE = 0.1f;
+
+    AudioStats stats{ 0, 0, 0, 0 };
+
+    size_t Index(SoundEvent event)
+    {
+        return static_cast<size_t>(event);
+    }
+}
+
+AudioEvents::AudioEvents() :
+    mPosted{},
+    mTrack(MusicTrack::NONE)
+{
+}
+
+void AudioEvents::Init(int shot_voices)
+{
+    // Every voice of the previous round is stopped and freed
+    for (auto& voices : mVoices)
+    {
+        voices.Release([](int handle)
+        {
+            MM::manager.StopSample(handle);
+            return false;
+        });
+    }
+
+    mVoices[Index(SoundEvent::SHOT)].Init(static_cast<size_t>(shot_voices));
+    mVoices[Index(SoundEvent::RECHARGE)].Init(1);
+    for (auto& posted : mPosted)
+        posted = false;
+
+    stats = AudioStats{ 0, shot_voices, 0, 0 };
+}
+
+void AudioEvents::Post(SoundEvent event)
+{
+    bool& posted = mPosted[Index(event)];
+    if (posted)
+        stats.mMerged++;
+    posted = true;
+}
+
+void AudioEvents::SetTrack(MusicTrack track)
+{
+    if (track == mTrack)
+        return;
+
+    const std::string& name = TRACK_NAMES[static_cast<size_t>(track)];
+    if (track == MusicTrack::NONE)
+        MM::manager.StopTrack();
+    else if (mTrack == MusicTrack::NONE)
+        MM::manager.PlayTrack(name);
+    else
+        MM::manager.ChangeTrack(name, TRACK_FADE);
+    mTrack = track;
+}
+
+void AudioEvents::Update()
+{
+    for (size_t i = 0; i < Index(SoundEvent::COUNT); i++)
+    {
+        auto& voices = mVoices[i];
+        voices.Release([](int handle)
+        {
+            return MM::manager.IsPlaying(handle);
+        });
+
+        if (!mPosted[i])
+            continue;
+        mPosted[i] = false;
+
+        // All voices are busy: the oldest sound is stopped instead of adding one more
+        int stolen = sim::VoicePool::NO_SOUND;
+        size_t voice = voices.Take(stolen);
+        if (stolen != sim::VoicePool::NO_SOUND)
+            MM::manager.StopSample(stolen);
+        voices.Set(voice, MM::manager.PlaySample(SOUND_NAMES[i]));
+    }
+
+    auto& shots = mVoices[Index(SoundEvent::SHOT)];
+    stats.mBusyShots = static_cast<int>(shots.Busy());
+    stats.mStolen = static_cast<int>(shots.Stolen());
+}
+
+const AudioStats& AudioEvents::Stats()
+{
+    return stats;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Sounds and music of the game passed to the audio engine once per frame
+ * \author Maksimovskiy A.S.
+ */
+
+#include "sim/VoicePool.h"
+
+// Sounds played by the game
+enum class SoundEvent
+{
+    // Shot of the gun
+    SHOT,
+    // Recharge of the gun
+    RECHARGE,
+    COUNT
+};
+
+// Music of the states of the game
+enum class MusicTrack
+{
+    NONE,
+    MAIN,
+    WIN,
+    LOSE
+};
+
+// Stats of the sounds for the debug overlay
+struct AudioStats
+{
+    // Busy voices of the shots and their count
+    int mBusyShots;
+    int mShotVoices;
+    // Shots stopped by the newer ones and the sounds merged with the same ones of their frame
+    int mStolen;
+    int mMerged;
+};
+
+// Sounds and music of the game. The sounds posted during a frame are started by Update, the same sounds
+// of one frame are played once. Each sound plays in a fixed count of voices: the shots in ShotVoices of input.txt,
+// the other sounds in one voice, and a new sound stops the oldest one of its voices.
+// The music is changed only when the state of the game changes.
+class AudioEvents
+{
+public:
+    AudioEvents();
+
+    // Creating the voices of the round. The sounds of the previous round are finished.
+    void Init(int shot_voices);
+
+    // Sound started on the next update
+    void Post(SoundEvent event);
+
+    // Music of the state. The track is changed only if the state differs from the current one.
+    void SetTrack(MusicTrack track);
+
+    // Freeing the voices of the ended sounds and starting the posted ones
+    void Update();
+
+    // Stats of the sounds
+    static const AudioStats& Stats();
+private:
+    // Voices of each sound in the order of SoundEvent
+    sim::VoicePool mVoices[static_cast<size_t>(SoundEvent::COUNT)];
+    // Sounds posted during the frame
+    bool mPosted[static_cast<size_t>(SoundEvent::COUNT)];
+
+    MusicTrack mTrack;
+};
@@ -6,38 +6,30 @@
 
 #include "stdafx.h"
 #include <boost/algorithm/string.hpp>
-#include <ctime>
-#include <corecrt_math_defines.h>
 
 #include "ClassHelpers.h"
 
 
-RandomGenerator::RandomGenerator() :
-    mGen(time(0))
+InputParser::InputParser() :
+    // The file is read through the mounted folder of the resources, not the working directory,
+    // so the watcher checks the same file
+    mWatcher(IO::Path::Combine(object_params::BaseDirectory(), "input.txt"))
 {
-}
+    // The game starts with the files having the retired params, only the changes of the file are checked strictly
+    if (!Read(mConfig, false))
+        throw std::runtime_error(std::string("Can't parse file: input.txt. ") + mError);
 
-RandomGenerator& RandomGenerator::Instance()
-{
-    static RandomGenerator rand_gen_instance;
-    return rand_gen_instance;
-}
-    
-int RandomGenerator::GenIntValue(int min, int max)
-{
-    std::uniform_int_distribution<> urd(min, max);
-    return urd(mGen);
+    // Remembering the current state of the file
+    mWatcher.Changed();
 }
-    
-float RandomGenerator::GetRealValue(int min, int max)
+
+InputParser& InputParser::Instance()
 {
-    std::uniform_real_distribution<> urd(min, max);
-    return static_cast<float>(urd(mGen));
+    static InputParser input_parser_instance;
+    return input_parser_instance;
 }
 
-/*********************************************************************************************************/
-
-InputParser::InputParser()
+bool InputParser::Read(sim::GameConfig& config, bool strict)
 {
     // Reading the file data
     IO::InputStreamPtr stream = Core::fileSystem.OpenRead("input.txt");
@@ -45,123 +37,113 @@ InputParser::InputParser()
     {
         IO::FileStreamPtr filestream = new IO::FileStream("input.txt");
         if (!filestream->IsValid())
-            throw std::runtime_error(std::string("Can't open file: input.txt"));
+        {
+            mError = "Can't open file: input.txt";
+            return false;
+        }
         stream = filestream;
     }
 
-    // The stream is copied to the character vector
     std::vector<uint8_t> buffer;
-    bool correct = stream->ReadAllBytes(buffer);
-    if (!correct)
-        throw std::runtime_error(std::string("Can't parse file: input.txt"));
-
-    // Map is formed from the symbols vector.
-    // Each line is read separately.
-    // All characters before '=' are the name of the parameter, after - the value.
-    // Only integer parameters are supported in this implementation.
-    auto begin_it = buffer.begin(), end_it = buffer.end();
-    while (begin_it != end_it)
-    {
-        auto mid_it = std::find(begin_it, end_it, '\n');
-        std::vector<std::string> parse;
-        std::string str(begin_it, mid_it);
-        auto r_it = str.find('\r');
-        if (r_it != std::string::npos)
-            str.erase(r_it, 1);
-        boost::split(parse, str, boost::is_any_of("="));
-        begin_it = mid_it;
-        if (mid_it != end_it)
-            ++begin_it;
-
-        if (parse.size() != 2)
-            continue;
-
-        mConfig.emplace(parse[0], utils::lexical_cast<int>(parse[1]));
-    }
-
-    // These settings can be set from input.txt, but for now the default
-    // Screen width
-    if (mConfig.find("Width") == mConfig.end())
-        mConfig.emplace("Width", 1024);
-    // Screen height
-    if (mConfig.find("Height") == mConfig.end())
-        mConfig.emplace("Height", 768);
-
-    // The bullets count in the gun
-    if (mConfig.find("BulletCount") == mConfig.end())
+    if (!stream->ReadAllBytes(buffer))
     {
-        int bullet_count = 15; // default
-        auto count_target = mConfig.find("CountTarget");
-        if (count_target != mConfig.end())
-            bullet_count = (*count_target).second;
-        mConfig.emplace("BulletCount", bullet_count);
+        mError = "Can't read file: input.txt";
+        return false;
     }
-}
 
-InputParser& InputParser::Instance()
-{
-    static InputParser input_parser_instance;
-    return input_parser_instance;
+    // Wrong values are errors. Unknown params of the changed file are errors too, so a typo in input.txt
+    // isn't silently ignored while the previous params are kept.
+    std::vector<std::string> errors;
+    std::vector<std::string> unknown;
+    bool correct = sim::ParseConfig(std::string(buffer.begin(), buffer.end()), config, errors, strict ? nullptr : &unknown);
+    for (auto& name : unknown)
+        Log::Warn("input.txt: unknown param " + name + " is ignored");
+    mError = boost::algorithm::join(errors, "; ");
+    return correct;
 }
 
-int InputParser::Get(const std::string& name)
+bool InputParser::Reload()
 {
-    auto find_id = mConfig.find(name);
-    if (find_id == mConfig.end())
-        return 0;
+    if (!mWatcher.Changed())
+        return false;
 
-    return (*find_id).second;
+    return Read(mConfig, true);
 }
 
 /*********************************************************************************************************/
 
-CosSinCalc::CosSinCalc()
-{
-    for (int i = 0; i < 360; i++)
-    {
-        mCos.emplace(i, math::cos(i * M_PI / 180));
-        mSin.emplace(i, math::sin(i * M_PI / 180));
-    }
-}
-
 CosSinCalc& CosSinCalc::Instance()
 {
     static CosSinCalc cos_sin_instance;
     return cos_sin_instance;
 }
 
-void CosSinCalc::CorrectAngle(int& angle)
+/*********************************************************************************************************/
+
+TextureAtlas::TextureAtlas() :
+    mTable{ std::string(), 0, 0, {} },
+    mTexture(nullptr)
 {
-    if (angle < 0)
-        angle += 360;
-    if (angle >= 360)
-        angle -= 360;
+    // The table is made by war_atlas together with the atlas image
+    IO::InputStreamPtr stream = Core::fileSystem.OpenRead("textures/atlas.txt");
+    if (!stream)
+        return;
+
+    std::vector<uint8_t> buffer;
+    if (!stream->ReadAllBytes(buffer))
+        return;
+
+    if (!sim::ParseAtlasTable(std::string(buffer.begin(), buffer.end()), mTable))
+        throw std::runtime_error(std::string("Can't parse file: textures/atlas.txt"));
+
+    mTexture = Core::resourceManager.Get<Render::Texture>("Atlas");
 }
 
-float CosSinCalc::Cos(int angle)
+TextureAtlas& TextureAtlas::Instance()
 {
-    CorrectAngle(angle);
-    auto find_id = mCos.find(angle);
-    if (find_id == mCos.end())
-        return 0;
+    static TextureAtlas atlas_instance;
+    return atlas_instance;
+}
 
-    return (*find_id).second;
+Render::Texture* TextureAtlas::Get(const std::string& name)
+{
+    const sim::AtlasRegion* region = mTexture ? mTable.Find(name) : nullptr;
+    if (!region)
+        return Core::resourceManager.Get<Render::Texture>(name);
+
+    auto& image = mImages[name];
+    if (!image)
+    {
+        image = std::make_unique<Render::PartialTexture>(mTexture, region->mX, region->mY, region->mWidth, region->mHeight);
+        mRects[image.get()] = IRect(region->mX, region->mY, region->mWidth, region->mHeight);
+    }
+    return image.get();
 }
 
-float CosSinCalc::Sin(int angle)
+Render::Texture* TextureAtlas::Source(Render::Texture* image, IRect& rect)
 {
-    CorrectAngle(angle);
-    auto find_id = mSin.find(angle);
-    if (find_id == mSin.end())
-        return 0;
+    auto find_id = mRects.find(image);
+    if (find_id == mRects.end())
+    {
+        rect = image->getBitmapRect();
+        rect.x = 0;
+        rect.y = 0;
+        return image;
+    }
 
-    return (*find_id).second;
+    rect = (*find_id).second;
+    return mTexture;
 }
 
 /*********************************************************************************************************/
 
 namespace object_params
 {
+    namespace
+    {
+        std::string base_directory;
+    }
+
     int InitSize(Render::Texture* tex, float& delta_x, float& delta_y)
     {
         // Getting a rectangle corresponding to the size of the texture
@@ -185,6 +167,25 @@ namespace object_params
 
     Render::Texture* GetText(const std::string& name)
     {
-        return Core::resourceManager.Get<Render::Texture>(name);
+        return TextureAtlas::Instance().Get(name);
+    }
+
+    std::string WriteDirectory()
+    {
+#if defined(ENGINE_TARGET_WIN32)
+        return "./write_directory";
+#else
+        return IO::Path::GetSpecialFolderPath(SpecialFolder::LocalDocuments);
+#endif
+    }
+
+    void SetBaseDirectory(const std::string& path)
+    {
+        base_directory = path;
+    }
+
+    const std::string& BaseDirectory()
+    {
+        return base_directory;
     }
 }
\ No newline at end of file
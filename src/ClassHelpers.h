@@ -1,34 +1,16 @@
 #pragma once
 
+#include "sim/Atlas.h"
+#include "sim/Config.h"
+#include "sim/Memory.h"
+#include "sim/Trig.h"
+
 /**
  * \file
  * \brief Helper classes
  * \author Maksimovskiy A.S.
  */
 
-#include <random> 
-
-// Singleton to generate random integers and real numbers
-class RandomGenerator
-{
-public:
-    // Instance
-    static RandomGenerator& Instance();
-    
-    // Generating integers from min to max
-    int GenIntValue(int min, int max);
-    
-    // Generating real numbers from min to max
-    float GetRealValue(int min, int max);
-private:
-    // Parameter for the distribution function
-    std::mt19937 mGen;
-    
-    RandomGenerator();
-    RandomGenerator(const RandomGenerator&) = delete;
-    RandomGenerator& operator=(RandomGenerator&) = delete;
-};
-
 // Singleton to get config params from input.txt
 class InputParser
 {
@@ -36,40 +18,82 @@ public:
     // Instance
     static InputParser& Instance();
     
-    // Method to get config param
-    int Get(const std::string& name);
+    // Current params. They are plain members, so reading them every frame costs nothing.
+    const sim::GameConfig& Config() const { return mConfig; }
+
+    // Reading input.txt again if it has changed on the disk. Returns true if the new params are applied.
+    // If the file has errors, the previous params are kept.
+    bool Reload();
+
+    // Errors of the last reading of input.txt or an empty string
+    const std::string& LastError() const { return mError; }
 private:
     InputParser();
     InputParser(const InputParser&) = delete;
     InputParser& operator=(InputParser&) = delete;
     
-    // Map for storing parsed params
-    std::map<std::string, int> mConfig;
+    // Reading the params from input.txt. Returns false on errors.
+    // Unknown params are errors if strict, otherwise they are written to the log and ignored.
+    bool Read(sim::GameConfig& config, bool strict);
+
+    sim::GameConfig mConfig;
+
+    // Changes of input.txt on the disk. The parser is created after Main.cpp sets the base directory.
+    sim::FileWatcher mWatcher;
+
+    std::string mError;
 };
 
-// Singleton for calculating cosines and sines of corners
+// Singleton for calculating cosines and sines of corners.
+// The values are taken from the flat table sim::TRIG_TABLE made at compile time.
 class CosSinCalc
 {
 public:
     // Instance
     static CosSinCalc& Instance();
     
-    // Method to get cos of corner
-    float Cos(int angle);
-    // Method to get sin of corner
-    float Sin(int angle);
+    // Method to get cos of corner in degrees. Fractions of a degree are interpolated.
+    float Cos(float angle) const { return sim::CosDeg(angle); }
+    // Method to get sin of corner in degrees
+    float Sin(float angle) const { return sim::SinDeg(angle); }
+    // Method to get both values at once
+    void SinCos(float angle, float& sin_out, float& cos_out) const { sim::SinCosDeg(angle, sin_out, cos_out); }
 private:
-    CosSinCalc();
+    CosSinCalc() = default;
     CosSinCalc(const CosSinCalc&) = delete;
     CosSinCalc& operator=(CosSinCalc&) = delete;
-    
-    // Map for storing cosines
-    std::map<int, float> mCos;
-    
-    // Map for storing sines
-    std::map<int, float> mSin;
-    
-    void CorrectAngle(int& angle);
+};
+
+// Singleton with the images packed into one texture by war_atlas.
+// Without textures/atlas.txt all images are separate textures.
+class TextureAtlas
+{
+public:
+    // Instance
+    static TextureAtlas& Instance();
+
+    // Texture of the image by its name in Resources.xml.
+    // The image packed into the atlas is a part of the atlas texture.
+    Render::Texture* Get(const std::string& name);
+
+    // Texture to bind for drawing the image and the rectangle of the image inside it
+    // in pixels from the top left corner
+    Render::Texture* Source(Render::Texture* image, IRect& rect);
+private:
+    TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(TextureAtlas&) = delete;
+
+    sim::AtlasTable mTable;
+
+    // Texture of the atlas, null if there is no atlas
+    Render::Texture* mTexture;
+
+    // Parts of the atlas texture by the names of the images
+    sim::TrackedMap<std::string, std::unique_ptr<Render::PartialTexture>, sim::MemTag::ATLAS> mImages;
+
+    // Rectangles of the parts in the atlas
+    sim::TrackedMap<Render::Texture*, IRect, sim::MemTag::ATLAS> mRects;
 };
 
 namespace object_params
@@ -80,5 +104,14 @@ namespace object_params
      // Method for calculating the angle between vectors
      float VectorsAngle(float x1, float x2, float x3, float x4);
      
+     // Texture of the image by its name. The images of the atlas are parts of one texture.
      Render::Texture* GetText(const std::string& name);
+
+     // Folder for the files written by the game
+     std::string WriteDirectory();
+
+     // Folder of the resources of the game mounted to the file system.
+     // The worker threads read the files from it without the file system of the engine.
+     void SetBaseDirectory(const std::string& path);
+     const std::string& BaseDirectory();
 }
\ No newline at end of file
@@ -0,0 +1,195 @@
+/**
+ * \file
+ * \brief Implementing the pool of the particle effects
+ * \author Maksimovskiy A.S.
+ */
+
+#include "stdafx.h"
+#include <boost/algorithm/string.hpp>
+
+#include "EffectPool.h"
+
+namespace
+{
+    // Names of the effects in WarEffects.xml in the order of EffectKind
+    const char* const EFFECT_NAMES[] = { "FlyBullet", "FlyBulletLite", "Shot", "HitObject" };
+
+    // Shares of the budget up to which the trails are full and cheap.
+    // The rest of the budget is left for the shots and hits.
+    const float FULL_TRAIL_SHARE = 0.5f;
+    const float CHEAP_TRAIL_SHARE = 0.75f;
+
+    EffectStats stats{ 0, 0, 0, 0, 0 };
+
+    size_t Index(EffectKind kind)
+    {
+        return static_cast<size_t>(kind);
+    }
+}
+
+EffectPool::EffectPool(EffectsContainer& container) :
+    mContainer(container)
+{
+}
+
+void EffectPool::LoadCosts()
+{
+    IO::InputStreamPtr stream = Core::fileSystem.OpenRead("WarEffects.xml");
+    if (!stream)
+        throw std::runtime_error(std::string("Can't open file: WarEffects.xml"));
+
+    std::vector<uint8_t> buffer;
+    if (!stream->ReadAllBytes(buffer))
+        throw std::runtime_error(std::string("Can't read file: WarEffects.xml"));
+
+    std::vector<std::string> errors;
+    if (!sim::ParseEffectCosts(std::string(buffer.begin(), buffer.end()), mCosts, errors))
+        throw std::runtime_error("WarEffects.xml: " + boost::algorithm::join(errors, "; "));
+
+    for (const char* name : EFFECT_NAMES)
+    {
+        if (sim::FindEffectCost(mCosts, name) < 0)
+            throw std::runtime_error(std::string("WarEffects.xml: no effect ") + name);
+    }
+}
+
+void EffectPool::Init(int particle_budget)
+{
+    // The effects of the previous round fade out by themselves
+    for (auto& effects : mEffects)
+    {
+        for (auto& effect : effects)
+        {
+            if (effect)
+                effect->Finish();
+        }
+        effects.clear();
+    }
+
+    // The effects are read once, the next rounds reuse them
+    if (mCosts.empty())
+        LoadCosts();
+
+    mBudget.Init(particle_budget);
+    for (size_t i = 0; i < Index(EffectKind::COUNT); i++)
+    {
+        mBudget.AddKind(sim::FindEffectCost(mCosts, EFFECT_NAMES[i]));
+        mEffects[i].resize(mBudget.Slots(i));
+    }
+
+    stats = EffectStats{ 0, particle_budget, 0, 0, 0 };
+}
+
+void EffectPool::Start(EffectKind kind, uint32_t slot, float x, float y)
+{
+    // The effect of the slot is still playing, so it is restarted instead of adding a new one
+    auto& effect = mEffects[Index(kind)][slot];
+    if (effect && !effect->isEnd())
+    {
+        effect->Reset();
+        stats.mRecycled++;
+    }
+    else
+        effect = mContainer.AddEffect(EFFECT_NAMES[Index(kind)]);
+
+    if (!effect)
+        return;
+
+    effect->posX = x;
+    effect->posY = y;
+}
+
+void EffectPool::Play(EffectKind kind, float x, float y)
+{
+    size_t index = Index(kind);
+    uint32_t slot = mBudget.Acquire(index);
+    if (slot == sim::EffectBudget::NO_SLOT)
+    {
+        // The budget is spent: the oldest effect of the kind is moved to the new place
+        slot = mBudget.Oldest(index);
+        if (slot == sim::EffectBudget::NO_SLOT)
+            return;
+        mBudget.Touch(index, slot);
+    }
+
+    Start(kind, slot, x, y);
+}
+
+EffectHandle EffectPool::StartTrail(float x, float y)
+{
+    EffectHandle handle;
+    if (mBudget.Fits(mBudget.Particles(Index(EffectKind::FLY_BULLET)), FULL_TRAIL_SHARE))
+        handle.mKind = EffectKind::FLY_BULLET;
+    else if (mBudget.Fits(mBudget.Particles(Index(EffectKind::FLY_BULLET_LITE)), CHEAP_TRAIL_SHARE))
+    {
+        handle.mKind = EffectKind::FLY_BULLET_LITE;
+        stats.mCheapTrails++;
+    }
+    else
+    {
+        stats.mSkippedTrails++;
+        return handle;
+    }
+
+    handle.mSlot = mBudget.Acquire(Index(handle.mKind));
+    if (!handle.Valid())
+    {
+        stats.mSkippedTrails++;
+        return handle;
+    }
+
+    Start(handle.mKind, handle.mSlot, x, y);
+    return handle;
+}
+
+void EffectPool::Move(const EffectHandle& handle, float x, float y)
+{
+    if (!handle.Valid())
+        return;
+
+    auto& effect = mEffects[Index(handle.mKind)][handle.mSlot];
+    if (!effect)
+        return;
+
+    effect->posX = x;
+    effect->posY = y;
+}
+
+void EffectPool::Stop(EffectHandle& handle)
+{
+    if (!handle.Valid())
+        return;
+
+    auto& effect = mEffects[Index(handle.mKind)][handle.mSlot];
+    if (effect)
+        effect->Finish();
+    handle = EffectHandle();
+}
+
+void EffectPool::Update()
+{
+    for (size_t i = 0; i < Index(EffectKind::COUNT); i++)
+    {
+        auto& effects = mEffects[i];
+        for (uint32_t slot = 0; slot < effects.size(); slot++)
+        {
+            if (!mBudget.IsBusy(i, slot))
+                continue;
+
+            // The ended effect is removed from the container, so the slot drops it too
+            auto& effect = effects[slot];
+            if (effect && !effect->isEnd())
+                continue;
+
+            effect = nullptr;
+            mBudget.Release(i, slot);
+        }
+    }
+
+    stats.mParticles = mBudget.LiveParticles();
+}
+
+const EffectStats& EffectPool::Stats()
+{
+    return stats;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Pool of the particle effects of the bullets within the budget of the particles
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "sim/EffectBudget.h"
+
+// Effects played by the game
+enum class EffectKind
+{
+    // Trail of the bullet and its cheap variant
+    FLY_BULLET,
+    FLY_BULLET_LITE,
+    // Shot of the gun
+    SHOT,
+    // Hit of the bullet
+    HIT_OBJECT,
+    COUNT
+};
+
+// Playing effect of the pool
+struct EffectHandle
+{
+    EffectKind mKind = EffectKind::COUNT;
+    uint32_t mSlot = sim::EffectBudget::NO_SLOT;
+
+    bool Valid() const { return mSlot != sim::EffectBudget::NO_SLOT; }
+};
+
+// Stats of the effects for the debug overlay
+struct EffectStats
+{
+    // Particles of the playing effects and their maximum count
+    int mParticles;
+    int mBudget;
+    // Trails of the last round played by the cheap variant or skipped
+    int mCheapTrails;
+    int mSkippedTrails;
+    // Effects restarted at a new place instead of a new instance
+    int mRecycled;
+};
+
+// Effects of the bullets added to the container through the slots of their kinds.
+// The names of the effects and the counts of their particles are read once, the slots are created for the round,
+// so the effects are limited by the budget of the live particles of input.txt.
+// A slot keeps its effect until it ends. When the budget is spent, the trails of the new bullets
+// become cheaper or are skipped and the oldest shot or hit is restarted at the new place.
+class EffectPool
+{
+public:
+    explicit EffectPool(EffectsContainer& container);
+
+    // Creating the slots for the budget of the particles. The effects of the previous round are finished.
+    void Init(int particle_budget);
+
+    // Effect played once at the point
+    void Play(EffectKind kind, float x, float y);
+
+    // Trail of a bullet at the point. Its level depends on the particles already playing.
+    EffectHandle StartTrail(float x, float y);
+
+    // Moving the trail after the bullet
+    void Move(const EffectHandle& handle, float x, float y);
+
+    // Finishing the trail. Its slot is free when the last particles end.
+    void Stop(EffectHandle& handle);
+
+    // Freeing the slots of the ended effects
+    void Update();
+
+    // Stats of the pool
+    static const EffectStats& Stats();
+private:
+    // Effect of the slot started at the point
+    void Start(EffectKind kind, uint32_t slot, float x, float y);
+
+    // Reading the particles of the effects from WarEffects.xml
+    void LoadCosts();
+
+    EffectsContainer& mContainer;
+    sim::EffectBudget mBudget;
+    // Particles of each effect of WarEffects.xml
+    std::vector<sim::EffectCost> mCosts;
+
+    // Effects of the slots of each kind. The kinds of the budget are in the order of EffectKind.
+    sim::TrackedVector<ParticleEffectPtr, sim::MemTag::EFFECTS> mEffects[static_cast<size_t>(EffectKind::COUNT)];
+};
@@ -1,4 +1,5 @@
 #include "stdafx.h"
+#include "ClassHelpers.h"
 #include "ShooterDelegate.h"
 
 #define MYAPPLICATION_NAME L"GameShooter"
@@ -11,11 +12,7 @@ int main(int argc, const char* argv[])
 {
     ParticleSystem::SetTexturesPath("textures/Particles");
 
-#if defined(ENGINE_TARGET_WIN32)
-    Core::fileSystem.SetWriteDirectory("./write_directory");
-#else
-    Core::fileSystem.SetWriteDirectory(IO::Path::GetSpecialFolderPath(SpecialFolder::LocalDocuments));
-#endif
+    Core::fileSystem.SetWriteDirectory(object_params::WriteDirectory());
     
 #if defined(ENGINE_TARGET_WIN32)
     std::string base_path = "base_p";
@@ -26,6 +23,7 @@ int main(int argc, const char* argv[])
 #endif
     
     Core::fileSystem.MountDirectory(base_path);
+    object_params::SetBaseDirectory(base_path);
 
     Log::log.AddSink(new Log::DebugOutputLogSink());
     Log::log.AddSink(new Log::HtmlFileLogSink("log.htm", true));
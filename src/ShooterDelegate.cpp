@@ -2,13 +2,18 @@
 #include "ClassHelpers.h"
 #include "ShooterDelegate.h"
 #include "ShooterWidget.h"
+#include "sim/Memory.h"
+#include "sim/Profiler.h"
+
+// Count of the longest zones of the frame shown in the debug overlay
+const size_t OVERLAY_ZONES = 8;
 
 
 void ShooterDelegate::GameContentSize(int deviceWidth, int deviceHeight, int &width, int &height)
 {
-    auto& inst = InputParser::Instance();
-    width = inst.Get(std::string("Width"));
-    height = inst.Get(std::string("Height"));
+    auto& config = InputParser::Instance().Config();
+    width = config.mWidth;
+    height = config.mHeight;
 }
 
 void ShooterDelegate::ScreenMode(DeviceMode &mode)
@@ -37,6 +42,7 @@ void ShooterDelegate::OnPostDraw()
     if (!Render::isFontLoaded("arial"))
         return;
 
+    PROFILE_ZONE("Overlay");
     Render::BindFont("arial");
 
     int dy = Render::getFontHeight();
@@ -50,4 +56,45 @@ void ShooterDelegate::OnPostDraw()
     Render::PrintString(x, y -= dy, std::string("Textures: ") + utils::lexical_cast(Core::resourceManager.GetMemoryInUse<Render::Texture>() / 1024) + std::string("K"), 1.0f, RightAlign, BottomAlign);
     Render::PrintString(x, y -= dy, std::string("Particles: ") + utils::lexical_cast(Core::resourceManager.GetMemoryInUse<ParticleEffect>() / 1024) + std::string("K"), 1.0f, RightAlign, BottomAlign);
     Render::PrintString(x, y -= dy, std::string("Models: ") + utils::lexical_cast(Core::resourceManager.GetMemoryInUse<Render::ModelAnimation>() / 1024) + std::string("K"), 1.0f, RightAlign, BottomAlign);
+
+    // Particles of the effects of the bullets and the trails made cheaper or skipped by their budget
+    auto& effects = EffectPool::Stats();
+    Render::PrintString(x, y -= dy, std::string("Effect particles: ") + utils::lexical_cast(effects.mParticles) + std::string(" / ") + utils::lexical_cast(effects.mBudget), 1.0f, RightAlign, BottomAlign);
+    Render::PrintString(x, y -= dy, std::string("Trails cheap/skipped: ") + utils::lexical_cast(effects.mCheapTrails) + std::string(" / ") + utils::lexical_cast(effects.mSkippedTrails) + std::string(", recycled: ") + utils::lexical_cast(effects.mRecycled), 1.0f, RightAlign, BottomAlign);
+
+    // Voices of the shots and the sounds stopped or merged by their limits
+    auto& audio = AudioEvents::Stats();
+    Render::PrintString(x, y -= dy, std::string("Shot voices: ") + utils::lexical_cast(audio.mBusyShots) + std::string(" / ") + utils::lexical_cast(audio.mShotVoices) + std::string(", stolen: ") + utils::lexical_cast(audio.mStolen) + std::string(", merged: ") + utils::lexical_cast(audio.mMerged), 1.0f, RightAlign, BottomAlign);
+
+    // Memory of our own subsystems: live and peak size and allocations in the last frame.
+    // In the steady state no subsystem allocates, so the frames with allocations stop growing.
+    auto& memory = sim::MemoryTracker::Instance();
+    for (size_t i = 0; i < sim::MEM_TAG_COUNT; i++)
+    {
+        sim::MemTag tag = static_cast<sim::MemTag>(i);
+        sim::MemoryStats stats = memory.Stats(tag);
+        Render::PrintString(x, y -= dy, std::string(sim::MemTagName(tag)) + std::string(": ") + utils::lexical_cast(stats.mLive / 1024) + std::string("K / ") + utils::lexical_cast(stats.mPeak / 1024) + std::string("K, ") + utils::lexical_cast(stats.mFrameAllocs) + std::string(" allocs"), 1.0f, RightAlign, BottomAlign);
+    }
+    Render::PrintString(x, y -= dy, std::string("Frames with allocs: ") + utils::lexical_cast(memory.AllocFrames()) + std::string(" / ") + utils::lexical_cast(memory.Frames()), 1.0f, RightAlign, BottomAlign);
+
+    // Errors of the changed input.txt. The previous params are used until they are fixed.
+    auto& config_error = InputParser::Instance().LastError();
+    if (!config_error.empty())
+        Render::PrintString(x, y -= dy, std::string("input.txt: ") + config_error, 1.0f, RightAlign, BottomAlign);
+
+    // Batching of the sprites in the last frame
+    auto& sprites = SpriteRenderer::LastFrameStats();
+    Render::PrintString(x, y -= dy, std::string("Sprites: ") + utils::lexical_cast(sprites.mSprites), 1.0f, RightAlign, BottomAlign);
+    Render::PrintString(x, y -= dy, std::string("Batches: ") + utils::lexical_cast(sprites.mBatches), 1.0f, RightAlign, BottomAlign);
+    Render::PrintString(x, y -= dy, std::string("Vertices: ") + utils::lexical_cast(sprites.mVertices), 1.0f, RightAlign, BottomAlign);
+
+    // Time of the frames and of the longest zones of the last frame with Profile=1 in input.txt
+    auto& profiler = sim::Profiler::Instance();
+    if (!profiler.IsEnabled())
+        return;
+
+    Render::PrintString(x, y -= dy, std::string("Frame p50/p99: ") + utils::lexical_cast(profiler.FramePercentile(0.5)) + std::string(" / ") + utils::lexical_cast(profiler.FramePercentile(0.99)) + std::string(" ms"), 1.0f, RightAlign, BottomAlign);
+    auto& zones = profiler.LastFrame();
+    for (size_t i = 0; i < zones.size() && i < OVERLAY_ZONES; i++)
+        Render::PrintString(x, y -= dy, std::string(zones[i].mName) + std::string(": ") + utils::lexical_cast(zones[i].mMs) + std::string(" ms"), 1.0f, RightAlign, BottomAlign);
 }
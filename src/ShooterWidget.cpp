@@ -1,22 +1,72 @@
 #include "stdafx.h"
 
+#include <ctime>
 #include <windows.h>
 
 #include "ClassHelpers.h"
 #include "ShooterWidget.h"
+#include "sim/Memory.h"
+#include "sim/Profiler.h"
+
+// Period of checking input.txt for changes in seconds
+const float CONFIG_CHECK_PERIOD = 0.5f;
+
+// Time of the frame for uploading the textures on the loading screen and during the round in seconds
+const double LOADING_BUDGET = 0.016;
+const double BACKGROUND_BUDGET = 0.002;
 
 ShooterWidget::ShooterWidget(const std::string& name, rapidxml::xml_node<>* elem)
     : Widget(name)
-    , mMachineGun()
+    , mWorld(static_cast<uint32_t>(time(0)))
+    , mSim(mWorld)
+    , mObjectsPool(mSim)
+    , mMachineGun(mSim, mAudio)
+    , mConfigTime(0.0f)
+    , mEndless(false)
+    , mEffects(mEffCont)
+    , mLoaded(false)
+    , mLoadProgress(0.0f)
 {
-    Init();
+    // The session is recorded from the start, so it can be replayed with war_replay
+    if (InputParser::Instance().Config().mRecord)
+    {
+        mRecorder.Begin(mWorld.Seed());
+        mWorld.SetRecorder(&mRecorder);
+    }
+
+    // The round is started by Update when its textures are loaded
+    mAssets.SetProgress([this](AssetGroup group, float progress, const std::string& id)
+    {
+        if (group != AssetGroup::WAR)
+            return;
+        mLoadProgress = progress;
+        mLoadName = id;
+    });
+    mAssets.Start();
+}
+
+ShooterWidget::~ShooterWidget()
+{
+    if (!mRecorder.IsRecording())
+        return;
+
+    // The simulation thread is idle after the flush, so the final state is complete
+    mSim.Flush();
+    mRecorder.Finish(mWorld);
+    mRecorder.Save(InputParser::Instance().Config().mRecordFile);
 }
 
 void ShooterWidget::Init()
 {
     mWinLoseResult = boost::none;
+    mEndless = InputParser::Instance().Config().mEndless;
+    ApplyConfig();
+    mEffects.Init(InputParser::Instance().Config().mParticleBudget);
+    mAudio.Init(InputParser::Instance().Config().mShotVoices);
     mMachineGun.InitBullets(true);
     mObjectsPool.Init(mMachineGun.Width(), mMachineGun.Height());
+    // The new round is drawn from the first frame
+    mSim.Flush();
     mClock = object_params::GetText("Clock");
     mTimer.Start();
 #if defined(ENGINE_TARGET_WIN32)
@@ -24,12 +74,60 @@ void ShooterWidget::Init()
 #endif
 }
 
+void ShooterWidget::ApplyConfig()
+{
+    // The world gets the params between its steps
+    auto& config = InputParser::Instance().Config();
+    sim::Profiler::Instance().SetEnabled(config.mProfile);
+    int tick_rate = config.mTickRate;
+    int max_ticks = config.mMaxTicks;
+    size_t threads = static_cast<size_t>(config.mThreads);
+    mSim.Post([=](sim::World& world)
+    {
+        world.SetTickRate(tick_rate, max_ticks);
+        world.SetThreadCount(threads);
+    });
+}
+
+void ShooterWidget::DrawLoading()
+{
+    auto& config = InputParser::Instance().Config();
+    int bar_width = config.mWidth / 2;
+    int x = (config.mWidth - bar_width) / 2;
+    int y = config.mHeight / 2;
+
+    Render::device.SetTexturing(false);
+    Render::BeginColor(Color("#FFFAFA"));
+    Render::DrawRect(x, y, bar_width, 20);
+    Render::EndColor();
+    Render::BeginColor(Color("#8B0000"));
+    Render::DrawRect(x + 2, y + 2, static_cast<int>((bar_width - 4) * mLoadProgress), 16);
+    Render::EndColor();
+    Render::device.SetTexturing(true);
+
+    // The font is uploaded by start.lua before the layer is shown
+    Render::BindFont("arial");
+    Render::BeginColor(Color("#8B0000"));
+    Render::PrintString(config.mWidth / 2, y + 50,
+                        utils::lexical_cast(static_cast<int>(mLoadProgress * 100)) + "% " + mLoadName,
+                        2.f, CenterAlign);
+    Render::EndColor();
+}
+
 void ShooterWidget::Draw()
 {
+    if (!mLoaded)
+    {
+        DrawLoading();
+        return;
+    }
+
     if (mWinLoseResult)
     {
         if (*mWinLoseResult)
         {
+            // The screens of the result are loaded in the background, so they are rarely uploaded here
+            mAssets.Require("WinBackground");
             Render::Texture* win = Core::resourceManager.Get<Render::Texture>("WinBackground");
             Render::device.PushMatrix();
             win->Draw();
@@ -38,6 +136,7 @@ void ShooterWidget::Draw()
         }
         else
         {
+            mAssets.Require("LoseBackground");
             Render::Texture* lose = Core::resourceManager.Get<Render::Texture>("LoseBackground");
             Render::device.PushMatrix();
             lose->Draw();
@@ -46,18 +145,21 @@ void ShooterWidget::Draw()
         }
     }
 
-    MM::manager.PlayTrack("MainTheme");
-    auto& inst = InputParser::Instance();
-    int width = inst.Get(std::string("Width"));
-    int height = inst.Get(std::string("Height"));
-    auto time_limit = inst.Get(std::string("Time"));
+    mAudio.SetTrack(MusicTrack::MAIN);
+    auto& config = InputParser::Instance().Config();
+    int width = config.mWidth;
+    int height = config.mHeight;
+    auto time_limit = config.mTime;
     auto delta_time = time_limit - static_cast<int>(mTimer.getElapsedTime());
-    
-    if (mObjectsPool.Empty() && delta_time > 0)
+
+    // The endless round has no result, the clock shows the time from its start
+    if (mEndless)
+        delta_time = static_cast<int>(mTimer.getElapsedTime());
+    else if (mObjectsPool.Cleared() && delta_time > 0)
     {
         mTimer.Resume();
         mWinLoseResult = true;
-        MM::manager.ChangeTrack("WinTheme", 0.1f);
+        mAudio.SetTrack(MusicTrack::WIN);
         return;
     }
     else if (delta_time <= 0)
@@ -65,7 +167,7 @@ void ShooterWidget::Draw()
         mTimer.Resume();
         mObjectsPool.Clear();
         mWinLoseResult = false;
-        MM::manager.ChangeTrack("LoseTheme", 0.1f);
+        mAudio.SetTrack(MusicTrack::LOSE);
         return;
     }
 
@@ -78,49 +180,101 @@ void ShooterWidget::Draw()
     Render::device.SetTexturing(true);
 
     // Drawing all targets
-    mObjectsPool.Draw();
+    {
+        PROFILE_ZONE("DrawTargets");
+        mSprites.BeginFrame();
+        mObjectsPool.Draw(mSprites);
+        mSprites.Flush();
+    }
 
     // Drawing the weapon
     mMachineGun.Draw();
     // Drawing the bullets
-    mMachineGun.BulletsDraw(mObjectsPool, mEffCont);
+    {
+        PROFILE_ZONE("DrawBullets");
+        mMachineGun.BulletsDraw(mEffects, mSprites);
+        mSprites.Flush();
+    }
 
-    // Remove all dead targets
-    mObjectsPool.DeleteDeadObjects();
+    // Drawing the number of remaining bullets in the gun and the time
+    {
+        PROFILE_ZONE("DrawHud");
+        mMachineGun.DrawOneBullet(width - 180, 25);
+        Render::BindFont("arial");
+        auto b_count = mMachineGun.BulletsCount();
 
-    // Drawing the number of remaining bullets in the gun
-    mMachineGun.DrawOneBullet(width - 180, 25);
-    Render::BindFont("arial");
-    auto b_count = mMachineGun.BulletsCount();
+        Render::BeginColor(Color("#8B0000"));
+        Render::PrintString(width - mMachineGun.Width()/2, 
+                            mMachineGun.Height()/2, 
+                            utils::lexical_cast(b_count),
+                            5.f, CenterAlign);
 
-    Render::BeginColor(Color("#8B0000"));
-    Render::PrintString(width - mMachineGun.Width()/2, 
-                        mMachineGun.Height()/2, 
-                        utils::lexical_cast(b_count),
-                        5.f, CenterAlign);
-
-    Render::PrintString(mMachineGun.Width() / 2,
-                        mMachineGun.Height() / 2,
-                        utils::lexical_cast(delta_time),
-                        5.f, CenterAlign);
-    Render::EndColor();
+        Render::PrintString(mMachineGun.Width() / 2,
+                            mMachineGun.Height() / 2,
+                            utils::lexical_cast(delta_time),
+                            5.f, CenterAlign);
+        Render::EndColor();
 
-    Render::device.PushMatrix();
-    Render::device.MatrixTranslate(mMachineGun.Width(), 0, 0);
-    mClock->Draw();
-    Render::device.PopMatrix();
+        Render::device.PushMatrix();
+        Render::device.MatrixTranslate(mMachineGun.Width(), 0, 0);
+        mClock->Draw();
+        Render::device.PopMatrix();
+    }
 
     // Draw all the effects that are added to the container
+    PROFILE_ZONE("DrawEffects");
     mEffCont.Draw();
 }
 
 void ShooterWidget::Update(float dt)
 {
-    mEffCont.Update(dt);
+    // The zones and the allocations of the previous frame are summed for the debug overlay
+    sim::Profiler::Instance().FrameMark();
+    sim::MemoryTracker::Instance().FrameMark();
+
+    // The changed input.txt is applied without restarting the game.
+    // The sizes and counts of the objects change on the next round.
+    mConfigTime += dt;
+    if (mConfigTime >= CONFIG_CHECK_PERIOD)
+    {
+        mConfigTime = 0.0f;
+        if (InputParser::Instance().Reload())
+            ApplyConfig();
+    }
+
+    // The textures of the round are uploaded on the loading screen, the rest ones during the round
+    if (!mLoaded)
+    {
+        mAssets.Update(LOADING_BUDGET);
+        if (!mAssets.Done(AssetGroup::WAR))
+            return;
+        mLoaded = true;
+        Init();
+    }
+    else
+        mAssets.Update(BACKGROUND_BUDGET);
+
+    // Moving targets and bullets, removing dead targets and used bullets.
+    // The simulation makes fixed steps, so its speed doesn't depend on the frame rate.
+    // The next state is calculated on the simulation thread while this frame is drawn.
+    if (!mWinLoseResult)
+        mSim.Frame(dt);
+
+    {
+        PROFILE_ZONE("UpdateEffects");
+        mEffCont.Update(dt);
+        mEffects.Update();
+    }
+
+    // The sounds of the shots and recharges of the frame
+    mAudio.Update();
 }
 
 bool ShooterWidget::MouseDown(const IPoint &mouse_pos)
 {
+    if (!mLoaded)
+        return false;
+
     if (Core::mainInput.GetMouseRightButton())
     {
     }
@@ -146,13 +300,28 @@ void ShooterWidget::AcceptMessage(const Message& message)
 void ShooterWidget::KeyPressed(int keyCode)
 {
     // Press on the key 'R' to reload weapons
-    if (keyCode == VK_R) 
+    if (keyCode == VK_R && mLoaded)
         mMachineGun.InitBullets(false, true);
 
+    // Press on the 'P' key to write the zones of the last seconds for chrome://tracing
+    if (keyCode == VK_P)
+    {
+        std::string name = "trace_" + utils::lexical_cast(static_cast<long long>(time(0))) + ".json";
+        sim::Profiler::Instance().WriteChromeTrace(IO::Path::Combine(object_params::WriteDirectory(), name),
+                                                   InputParser::Instance().Config().mTraceSeconds);
+    }
+
+    // Press on the 'M' key to write the memory of the subsystems as CSV
+    if (keyCode == VK_M)
+    {
+        std::string name = "memory_" + utils::lexical_cast(static_cast<long long>(time(0))) + ".csv";
+        sim::MemoryTracker::Instance().WriteReport(IO::Path::Combine(object_params::WriteDirectory(), name));
+    }
+
     // Press on the 'B' key, the game will start again
-    if (keyCode == VK_B)
+    if (keyCode == VK_B && mLoaded)
     {
-        MM::manager.ChangeTrack("MainTheme", 0.1f);
+        mAudio.SetTrack(MusicTrack::MAIN);
         Init();
     }
 }
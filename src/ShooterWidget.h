@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AssetLoader.h"
 #include "ObjectsForShot.h"
 #include "Weapons.h"
 
@@ -8,6 +9,7 @@ class ShooterWidget : public GUI::Widget
 {
 public:
     ShooterWidget(const std::string& name, rapidxml::xml_node<>* elem);
+    ~ShooterWidget();
     
     void Draw() override;
     void Update(float dt) override;
@@ -23,17 +25,49 @@ public:
 
 private:
     void Init();
+
+    // Progress bar of the textures of the round
+    void DrawLoading();
+
+    // Passing the params of input.txt to the simulation
+    void ApplyConfig();
     
+    // Log of the session if the recording is enabled in input.txt
+    sim::Recorder mRecorder;
+    // Simulation of the targets and bullets
+    sim::World mWorld;
+    // Thread advancing the simulation while the frame is drawn
+    sim::SimThread mSim;
+    // Sounds and music passed to the engine once per frame
+    AudioEvents mAudio;
     // Target management class object
     ObjectsPool mObjectsPool;
     // Weapons and bullet class object
     MachineGun mMachineGun;
     
+    // Sprites of the targets and bullets drawn by one call per texture
+    SpriteRenderer mSprites;
+
     // Timer
     Core::Timer mTimer;
+
+    // Time since the last check of input.txt
+    float mConfigTime;
+
+    // The round is in the endless mode. The mode of input.txt is applied on the restart.
+    bool mEndless;
     
     // Objects for drawing effects
     EffectsContainer mEffCont;
+    // Effects of the bullets within the budget of the particles
+    EffectPool mEffects;
+    
+    // Textures loaded on the worker threads. The round starts when the textures of the round are loaded.
+    AssetLoader mAssets;
+    bool mLoaded;
+    // Share of the loaded textures of the round and the last loaded one for the loading screen
+    float mLoadProgress;
+    std::string mLoadName;
     
     // Texture to display the clock
     Render::Texture* mClock;
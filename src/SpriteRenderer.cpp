@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \brief Implementing the drawing of the sprites by one call per texture
+ * \author Maksimovskiy A.S.
+ */
+
+#include "stdafx.h"
+
+#include "ClassHelpers.h"
+#include "SpriteRenderer.h"
+
+namespace
+{
+    // Stats of the last drawn frame
+    sim::BatchStats last_frame_stats{ 0, 0, 0 };
+
+    // Color of the vertices. The textures are drawn without tinting.
+    const DWORD WHITE = 0xffffffff;
+}
+
+SpriteRenderer::SpriteRenderer() :
+    mFrameStats{ 0, 0, 0 }
+{
+}
+
+void SpriteRenderer::BeginFrame()
+{
+    last_frame_stats = mFrameStats;
+    mFrameStats = sim::BatchStats{ 0, 0, 0 };
+    mBatch.Clear();
+}
+
+size_t SpriteRenderer::Frame(Render::Texture* image)
+{
+    size_t frame = mBatch.FindFrame(image);
+    if (frame != sim::SpriteBatch::NO_FRAME)
+        return frame;
+
+    IRect rect;
+    Render::Texture* texture = TextureAtlas::Instance().Source(image, rect);
+
+    // Texture coordinates of the image inside the texture.
+    // The rows of the image go down, v of the texture goes up like y of the screen.
+    IRect bitmap = texture->getBitmapRect();
+    float width = static_cast<float>(bitmap.width);
+    float height = static_cast<float>(bitmap.height);
+    FRect frect(bitmap);
+    FRect uv(rect.x / width, (rect.x + rect.width) / width,
+             (height - rect.y - rect.height) / height, (height - rect.y) / height);
+    texture->TranslateUV(frect, uv);
+
+    frame = mBatch.Frame(image, texture, static_cast<float>(rect.width), static_cast<float>(rect.height),
+                         sim::UvRect{ uv.xStart, uv.yStart, uv.xEnd, uv.yEnd });
+
+    // The frame of a new texture has added a group
+    if (mBatch.Groups().size() > mTextures.size())
+    {
+        mTextures.push_back(texture);
+        mBuffers.push_back(std::make_unique<Render::VertexBufferIndexed>());
+        mCapacity.push_back(0);
+    }
+    return frame;
+}
+
+void SpriteRenderer::Add(size_t frame, float x, float y, float angle)
+{
+    if (angle == 0.0f)
+        mBatch.Add(frame, x, y);
+    else
+        mBatch.Add(frame, x, y, angle);
+}
+
+void SpriteRenderer::Flush()
+{
+    sim::BatchStats stats = mBatch.Stats();
+    mFrameStats.mSprites += stats.mSprites;
+    mFrameStats.mBatches += stats.mBatches;
+    mFrameStats.mVertices += stats.mVertices;
+
+    auto& groups = mBatch.Groups();
+    for (size_t g = 0; g < groups.size(); g++)
+    {
+        auto& vertices = groups[g].mVertices;
+        if (vertices.empty())
+            continue;
+
+        // The buffer grows twice, so it is recreated only a few times.
+        // The quads not used in this frame are degenerate and aren't visible.
+        size_t quads = vertices.size() / 4;
+        auto& buffer = *mBuffers[g];
+        if (mCapacity[g] < quads)
+        {
+            mCapacity[g] = std::max(quads, mCapacity[g] * 2);
+            buffer.InitQuadBuffer(static_cast<int>(mCapacity[g]));
+        }
+
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            auto& v = vertices[i];
+            buffer._buffer[i] = Render::QuadVert(v.x, v.y, 0.0f, WHITE, v.u, v.v);
+        }
+        std::fill(buffer._buffer.begin() + vertices.size(), buffer._buffer.end(), Render::QuadVert());
+
+        mTextures[g]->Bind();
+        buffer.Upload();
+        buffer.Draw();
+    }
+
+    mBatch.Clear();
+}
+
+const sim::BatchStats& SpriteRenderer::LastFrameStats()
+{
+    return last_frame_stats;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Drawing of the sprites by one call per texture
+ * \author Maksimovskiy A.S.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "sim/SpriteBatch.h"
+
+// Class collecting the sprites of targets and bullets and drawing each texture by one call.
+// The vertices are built by sim::SpriteBatch, the class only passes them to the engine.
+class SpriteRenderer
+{
+public:
+    SpriteRenderer();
+
+    // Start of a new frame. The stats of the previous one become available by LastFrameStats.
+    void BeginFrame();
+
+    // Index of the sprite frame of the image. The images of the atlas are drawn from the atlas texture.
+    size_t Frame(Render::Texture* image);
+
+    // Adding the sprite with the image corner at the point, rotated by the angle in degrees
+    void Add(size_t frame, float x, float y, float angle = 0.0f);
+
+    // Drawing all collected sprites
+    void Flush();
+
+    // Stats of the last drawn frame
+    static const sim::BatchStats& LastFrameStats();
+private:
+    sim::SpriteBatch mBatch;
+
+    // Bound textures and vertex buffers of the groups
+    sim::TrackedVector<Render::Texture*, sim::MemTag::SPRITES> mTextures;
+    sim::TrackedVector<std::unique_ptr<Render::VertexBufferIndexed>, sim::MemTag::SPRITES> mBuffers;
+    // Count of the quads in each buffer
+    sim::TrackedVector<size_t, sim::MemTag::SPRITES> mCapacity;
+
+    // Stats of the current frame
+    sim::BatchStats mFrameStats;
+};
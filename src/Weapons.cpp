@@ -14,12 +14,30 @@
 
 // 180 degree angle
 const float PI_DEGREES = 180.0f;
-// Time discrete
-static float TIME_DELTA = 0.1f;
-// Acceleration of gravity
-const float G = 9.81f;
-// Air resistance (kg / m ^ 3)
-const float RHO = 1.23;
+
+namespace
+{
+    // Search for the state of the bullet by its identifier.
+    // The bullets in flight and the removed ones of all steps of the update are both ordered by their identifiers,
+    // so the search continues from the cursor.
+    const sim::Bullet* FindBullet(const sim::TrackedVector<sim::Bullet, sim::MemTag::SNAPSHOT>& bullets, size_t& cursor, uint32_t id)
+    {
+        while (cursor < bullets.size() && bullets[cursor].mId < id)
+            ++cursor;
+
+        if (cursor < bullets.size() && bullets[cursor].mId == id)
+            return &bullets[cursor];
+
+        return nullptr;
+    }
+
+    // Position of the bullet for drawing. The flying bullet is drawn between its last two steps,
+    // the used one at the point where it stopped.
+    sim::Vec2 DrawPoint(const sim::Bullet& state, float alpha)
+    {
+        return state.mIsUsed ? state.Point() : state.Point(alpha);
+    }
+}
 
 void Aim::Draw()
 {
@@ -38,222 +56,92 @@ void Aim::Draw()
 
 /**********************************************************************************/
 
-Bullet::Bullet() : mIsUsed(false)
-{
-    mVelocity = InputParser::Instance().Get(std::string("Speed"));
-    mSystemAngle = 0;
-    mFirstDraw = false;
-    mOneBulletTexture = object_params::GetText("OneBullet");
-}
-
-float* Bullet::RKFunc(float* xy_old)
-{
-    float* y = new float[N_DIM];
-
-    y[0] = xy_old[1];
-    // Vx change
-    y[1] = -mCm * xy_old[1] - mKm * xy_old[3];
-    y[2] = xy_old[3];
-    // Vy change
-    y[3] = -G - mCm * xy_old[3] + mKm * xy_old[1];
-
-    return (y);
-}
-
-void Bullet::CalcAngles(float rotate_angle)
+BulletPrototype MakePistolPrototype()
 {
-    float ang = rotate_angle * M_PI / PI_DEGREES;
-
-    // Initial position, initial speed, shot angle
-    // x0
-    mXYold[0] = mCurrentPoint.x;
-    // vx0
-    mXYold[1] = mVelocity * cos(ang) * (mInvert ? -1 : 1);
-    // y0
-    mXYold[2] = mCurrentPoint.y;
-    // vy0
-    mXYold[3] = mVelocity * sin(ang) * (mInvert ? -1 : 1);
-    // Shot angle
-    mSystemAngle = rotate_angle;
+    BulletPrototype type;
+    type.mTexture = object_params::GetText("Bullet");
+    type.mOneBulletTexture = object_params::GetText("OneBullet");
+    int size = object_params::InitSize(type.mTexture, type.mDeltaX, type.mDeltaY);
+    type.mDesc = sim::MakePistolBullet(InputParser::Instance().Config().mSpeed, size);
+    return type;
 }
 
-void Bullet::Move()
-{
-    /**
-    * In this method, the movement of the bullet is calculated as for an object launched at an angle to the horizon.
-    * But in addition to the action of gravity, factors such as 
-    * air resistance, angular velocity and wind action are also taken into account.
-    * From the second law of Newton a = F / m, whence it follows that
-    * d^2(x)/dt^2 = dvx/dt = (-(c/m) * vx - (k/m) * vy) * sqrt(vx * vx + vy * vy)
-    * d^2(y)/dt^2 = dvy/dt = ((k/m) * vx - (c/m) * vy) * sqrt(vx * vx + vy * vy) - g ,
-    * where с = (1/2) * Сd * A * ro, k = (1/2) * Cl * A * ro.
-    * c is the drag coefficient due to air resistance,
-    * k - offset factor due to angular velocity and wind
-    * A - the cross-sectional area of ​​the bullet (or any other object)
-    * ro - air resistance
-    * Cd - deceleration parameter, Cl - offset parameter
-    * Cd = 0.30 + (2.58 * 10^(-4)) * w
-    * Cl = 0.319 * (1 - exp(-2.48 * 10^(-3) * w)), where w is the angular velocity in rad / s
-    *
-    * Further, the RK4 method is used - one of the Runge-Kutta family of numerical methods.
-    * At each step n and at time iteration dt, it turns out
-    * xy[n+1] = xy[n] + (1/6) * (k1 + 2*k2 + 2*k3 + k4), где
-    * k1 = dt * RK4(xy[n])
-    * k2 = dt * RK4(xy[n] + k1 / 2)
-    * k3 = dt * RK4(xy[n] + k2 / 2)
-    * k4 = dt * RK4(xy[n] + k3)
-    *
-    * xy - at each iteration n, this is an array of 4 elements:
-    * current x and y coordinates and velocity projections vx and vy
-    */
-
-    // If the bullet did not hit one target,
-    // it is considered used when it hits the ground.
-    if (mXYold[2] < -0.001)
-    {
-        mIsUsed = true;
-        return;
-    }
-
-    float y_new[N_DIM];
-    float y1[N_DIM];
-    float y2[N_DIM];
-    float y3[N_DIM];
-
-    // k1 = f(tn, yn)
-    float* k1 = RKFunc(mXYold);
-    for (int i = 0; i < N_DIM; i++)
-        y1[i] = mXYold[i] + 0.5 * TIME_DELTA * k1[i];
-
-    // k2 = f(tn + h/2, yn + k1/2)
-    float* k2 = RKFunc(y1);
-    for (int i = 0; i < N_DIM; i++)
-        y2[i] = mXYold[i] + 0.5 * TIME_DELTA * k2[i];
-
-    // k3 = f(tn + h/2, yn + k2/2)
-    float* k3 = RKFunc(y2);
-    for (int i = 0; i < N_DIM; i++)
-        y3[i] = mXYold[i] + TIME_DELTA * k3[i];
-
-    // k4 = f(tn + h/2, yn + k3)
-    float* k4 = RKFunc(y3);
-
-    for (int i = 0; i < N_DIM; i++)
-        y_new[i] = mXYold[i] + TIME_DELTA * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]) / 6.0;
-
-    mCurrentPoint.x = y_new[0];
-    mCurrentPoint.y = y_new[2];
-    for (int i = 0; i < N_DIM; i++)
-        mXYold[i] = y_new[i];
-
-    delete[] k1;
-    delete[] k2;
-    delete[] k3;
-    delete[] k4;
-}
+/**********************************************************************************/
 
-void Bullet::SimpleDraw()
+void Bullet::Reset(const BulletPrototype* type)
 {
-    Render::device.PushMatrix();
-    Render::device.MatrixTranslate(mCurrentPoint.x - mDeltaX, mCurrentPoint.y - mDeltaY, 0);
-    auto angle = acos(mXYold[3] / sqrt(mXYold[3] * mXYold[3] + mXYold[1] * mXYold[1]));
-    float real_angle = mSystemAngle + angle * PI_DEGREES / M_PI * (mInvert ? 1 : -1);
-    Render::device.MatrixRotate(math::Vector3(0, 0, 1), mInvert ? PI_DEGREES + real_angle : real_angle);
-    mTexture->Draw();
-    Render::device.PopMatrix();
+    mType = type;
+    mId = 0;
+    mCurrentPoint = FPoint();
+    mTargetPoint = FPoint();
+    mTrail = EffectHandle();
+    mFirstDraw = false;
 }
 
-void Bullet::Draw(ObjectsPool& shot_objects)
+void Bullet::SimpleDraw(const sim::Bullet& state, float alpha, SpriteRenderer& sprites)
 {
-    // Move the bullet on the current iteration
-    Move();
-
-    // Check for hit on any of the objects.
-    // If there was a hit, then we do not draw a bullet.
-    bool used = shot_objects.CheckHitForObjects(mCurrentPoint, mSize, mXYold[1], mXYold[3], static_cast<int>(mDamage));
-    if (used)
-        mIsUsed = true;
-
-    SimpleDraw();
+    const float* xy = state.mXY;
+    sim::Vec2 point = DrawPoint(state, alpha);
+    auto angle = acos(xy[3] / sqrt(xy[3] * xy[3] + xy[1] * xy[1]));
+    float real_angle = state.mSystemAngle + angle * PI_DEGREES / M_PI * (state.mInvert ? 1 : -1);
+    sprites.Add(sprites.Frame(mType->mTexture), point.x - mType->mDeltaX, point.y - mType->mDeltaY,
+                state.mInvert ? PI_DEGREES + real_angle : real_angle);
 }
 
-void Bullet::DrawEffects(EffectsContainer& eff_cont)
+void Bullet::DrawEffects(const sim::Bullet& state, float alpha, EffectPool& effects)
 {
-    if (!mFlyEffect)
-        mFlyEffect = eff_cont.AddEffect("FlyBullet");
-    
-    if (mFlyEffect)
-    {
-        mFlyEffect->posX = mCurrentPoint.x - mDeltaX;
-        mFlyEffect->posY = mCurrentPoint.y - mDeltaY;
-
-        if (mIsUsed)
-            mFlyEffect->Finish();
-    }
+    sim::Vec2 point = DrawPoint(state, alpha);
+    mCurrentPoint = FPoint(point.x, point.y);
+    float x = mCurrentPoint.x - mType->mDeltaX;
+    float y = mCurrentPoint.y - mType->mDeltaY;
 
+    // The level of the trail is chosen on the shot, so it doesn't change during the flight
     if (mFirstDraw)
     {
-        auto shot_effect = eff_cont.AddEffect("Shot");
-        shot_effect->posX = mCurrentPoint.x - mDeltaX;
-        shot_effect->posY = mCurrentPoint.y - mDeltaY;
-        shot_effect->Reset();
+        effects.Play(EffectKind::SHOT, x, y);
+        mTrail = effects.StartTrail(x, y);
         mFirstDraw = false;
     }
 
-    if (!mIsUsed)
-        return;
-
-    if (!mHitEffect)
-        mHitEffect = eff_cont.AddEffect("HitObject");
-    if (!mHitEffect)
+    effects.Move(mTrail, x, y);
+    if (!state.mIsUsed)
         return;
 
-    mHitEffect->posX = mCurrentPoint.x - mDeltaX;
-    mHitEffect->posY = mCurrentPoint.y - mDeltaY;
-    mHitEffect->Reset();
+    effects.Stop(mTrail);
+    effects.Play(EffectKind::HIT_OBJECT, x, y);
 }
 
-void Bullet::DrawBulletIndicator()
+/**********************************************************************************/
+
+void BulletPool::Init(size_t capacity)
 {
-    Render::device.PushMatrix();
-    Render::device.MatrixTranslate(mCurrentPoint.x, mCurrentPoint.y, 0);
-    mOneBulletTexture->Draw();
-    Render::device.PopMatrix();
+    mBullets.assign(capacity, Bullet());
+    mFree.resize(capacity);
+    // The bullets are taken from the end, so the first ones are used first
+    for (size_t i = 0; i < capacity; i++)
+        mFree[i] = static_cast<uint32_t>(capacity - 1 - i);
 }
 
-/**********************************************************************************/
+uint32_t BulletPool::Acquire()
+{
+    if (mFree.empty())
+        return NO_BULLET;
+
+    uint32_t index = mFree.back();
+    mFree.pop_back();
+    return index;
+}
 
-PistolBullet::PistolBullet() : Bullet()
+void BulletPool::Release(uint32_t index)
 {
-    mTexture = object_params::GetText("Bullet");
-    float dx, dy;
-    mSize = object_params::InitSize(mTexture, dx, dy);
-
-    mDeltaX = dx;
-    mDeltaY = dy;
-    mDamage = Damage::SMALL;
-
-    // Angular velocity
-    float rpm = 5.0f;
-    // Convert to rad/s
-    float w = rpm * M_PI / 30.00;
-    // Cross sectional area in m ^ 2
-    float S = 0.0021;
-    // Bullet mass in kg
-    float m = 0.018;
-
-    // Drag coefficient
-    float CD = 0.30 + 2.58e-4 * w;
-    mCm = 0.5 * CD * S * RHO / m;
-
-    // Swift factor
-    float CL = 0.3187 * (1.0 - exp(-2.483e-3 * w));
-    mKm = 0.5 * CL * S * RHO / m; 
+    mFree.push_back(index);
 }
 
 /**********************************************************************************/
 
-MachineGun::MachineGun() : 
+MachineGun::MachineGun(sim::SimThread& sim, AudioEvents& audio) : 
+    mSim(sim),
+    mAudio(audio),
     mIsRecharged(false),
     mRotateAngle(0),
     mInvert(false)
@@ -268,86 +156,104 @@ MachineGun::MachineGun() :
 
     mAim.mTexture = object_params::GetText("Aim");
 
-    auto& inst = InputParser::Instance();
-    mWinWidth = inst.Get(std::string("Width"));
+    auto& config = InputParser::Instance().Config();
+    mWinWidth = config.mWidth;
     mX = static_cast<float>(mWinWidth / 2);
-
-    size_t bullets_count = inst.Get(std::string("BulletCount"));
-    mBulletPool.reserve(bullets_count);
-    mUsedBulletPool.reserve(bullets_count);
 }
 
 void MachineGun::InitBullets(bool restart, bool recharge)
 {
-    mWeaponTimer.Resume();
-
+    size_t bullets_count = InputParser::Instance().Config().mBulletCount;
     if (restart)
     {
-        mBulletPool.clear();
-        std::for_each(mUsedBulletPool.begin(), mUsedBulletPool.end(), [](bullet_ptr& bullet_obj)
+        // The trails of the bullets in flight are finished by the effect pool on the start of the round
+        mUsedBullets.clear();
+        mMagazine.clear();
+
+        // The attributes are calculated once per round, so the changed input.txt is applied on restart.
+        // The store and the bullets of the previous one still in flight fit into the pool.
+        // The simulation reserves as many bullets, so the shots don't allocate memory there either.
+        size_t capacity = 2 * bullets_count;
+        mSim.Post([capacity](sim::World& world)
         {
-            if (bullet_obj->mFlyEffect)
-                bullet_obj->mFlyEffect->Finish();
+            world.ClearBullets();
+            world.ReserveBullets(capacity);
         });
-        mUsedBulletPool.clear();
+        mPistol = MakePistolPrototype();
+        mBulletPool.Init(capacity);
+        mMagazine.reserve(bullets_count);
+        mUsedBullets.reserve(mBulletPool.Capacity());
     }
 
     if (recharge)
     {
-        MM::manager.PlaySample("RechargeSound");
+        mAudio.Post(SoundEvent::RECHARGE);
         mRechargeTimer.Start();
         mIsRecharged = true;
     }
 
-    auto& inst = InputParser::Instance();
-    size_t bullets_count = inst.Get(std::string("BulletCount"));
-    size_t current_size = mBulletPool.size();
-    for (size_t i = 0; i < bullets_count - current_size; i++)
-        mBulletPool.push_back(std::make_unique<PistolBullet>());
-    mOneBullet = std::make_unique<PistolBullet>();
-    
-    mWeaponTimer.Start();
-    mPrevTime = 0.0f;
+    // The count may be less than the current one after input.txt is changed.
+    // If all bullets of the pool are in flight, the store is filled only partially.
+    for (size_t i = mMagazine.size(); i < bullets_count; i++)
+    {
+        uint32_t index = mBulletPool.Acquire();
+        if (index == BulletPool::NO_BULLET)
+            break;
+
+        mBulletPool[index].Reset(&mPistol);
+        mMagazine.push_back(index);
+    }
 }
 
-void MachineGun::BulletsDraw(ObjectsPool& shot_objects, EffectsContainer& eff_cont)
+void MachineGun::BulletsDraw(EffectPool& effects, SpriteRenderer& sprites)
 {
-    auto curr_time = mWeaponTimer.getElapsedTime();
-    TIME_DELTA = (curr_time - mPrevTime) * 10;
-    mPrevTime = curr_time;
-
-    if (mBulletPool.size() == 0)
+    if (mMagazine.empty())
     {
         Render::device.PushMatrix();
         mRechargeTexture->Draw();
         Render::device.PopMatrix();
     }
 
-    for (auto bullet_it = mUsedBulletPool.begin(); bullet_it != mUsedBulletPool.end(); bullet_it++)
-    {
-        (*bullet_it)->Draw(shot_objects);
-        (*bullet_it)->DrawEffects(eff_cont);
-    }
+    // The fired bullets are either still in flight or were removed by the simulation on the last update
+    auto& frame = mSim.Front();
+    size_t flying_cursor = 0;
+    size_t retired_cursor = 0;
 
-    auto delete_func = [](bullet_ptr& b_object) -> bool
+    auto delete_func = [&](uint32_t index) -> bool
     {
-        bool is_used = b_object->mIsUsed;
+        Bullet* b_object = &mBulletPool[index];
+        // The bullet is fired, but the simulation hasn't processed it yet
+        if (b_object->mId > frame.mLastBulletId)
+            return false;
+
+        const sim::Bullet* state = FindBullet(frame.mBullets, flying_cursor, b_object->mId);
+        if (!state)
+            state = FindBullet(frame.mRetired, retired_cursor, b_object->mId);
+
+        if (state)
+        {
+            b_object->SimpleDraw(*state, frame.mAlpha, sprites);
+            b_object->DrawEffects(*state, frame.mAlpha, effects);
+        }
+
+        bool is_used = !state || state->mIsUsed;
         if (!is_used)
             return false;
 
-        b_object->mFlyEffect = nullptr;
-        b_object->mHitEffect = nullptr;
-        b_object->mTexture = nullptr;
+        effects.Stop(b_object->mTrail);
+        mBulletPool.Release(index);
         return true;
     };
 
-    mUsedBulletPool.erase(std::remove_if(mUsedBulletPool.begin(), mUsedBulletPool.end(), delete_func), mUsedBulletPool.end());
+    mUsedBullets.erase(std::remove_if(mUsedBullets.begin(), mUsedBullets.end(), delete_func), mUsedBullets.end());
 }
 
 void MachineGun::DrawOneBullet(float x, float y)
 {
-    mOneBullet->mCurrentPoint = FPoint(x, y);
-    mOneBullet->DrawBulletIndicator();
+    Render::device.PushMatrix();
+    Render::device.MatrixTranslate(x, y, 0);
+    mPistol.mOneBulletTexture->Draw();
+    Render::device.PopMatrix();
 }
 
 void MachineGun::RotateGun()
@@ -393,29 +299,30 @@ void MachineGun::Draw()
 
 bool MachineGun::Shot()
 {
-    if (mBulletPool.size() == 0 || mShotTimer.getElapsedTime() < 0.5f || mIsRecharged)
+    if (mMagazine.empty() || mShotTimer.getElapsedTime() < 0.5f || mIsRecharged)
         return false;
 
-    MM::manager.PlaySample("ShotSound");
+    mAudio.Post(SoundEvent::SHOT);
     mShotTimer.Resume();
-    bullet_ptr bullet = std::move(mBulletPool[mBulletPool.size()-1]);
-    mBulletPool.pop_back();
+    uint32_t index = mMagazine.back();
+    mMagazine.pop_back();
+    Bullet* bullet = &mBulletPool[index];
     bullet->mTargetPoint = mAim.mPoint;
-    bullet->mInvert = mInvert;
 
     // The initial position of the bullet corresponds to the top of the texture describing the weapon, 
     // turned at an angle relative to the aim
     auto rotate_angle = mInvert ? mRotateAngle - PI_DEGREES / 2 : mRotateAngle;
-    auto angle = rotate_angle * M_PI / PI_DEGREES;
-    auto init_x = mWidth * math::cos(angle) - mHeight * math::sin(angle) + mX;
-    auto init_y = mHeight * math::cos(angle) + mWidth * math::sin(angle);
+    float sin_angle, cos_angle;
+    sim::SinCosDeg(rotate_angle, sin_angle, cos_angle);
+    auto init_x = mWidth * cos_angle - mHeight * sin_angle + mX;
+    auto init_y = mHeight * cos_angle + mWidth * sin_angle;
 
     // Adjusting the initial position of the bullet
     auto init_point = FPoint(mInvert ? mWinWidth - init_x : init_x, abs(init_y));
     bullet->mCurrentPoint = init_point;
-    bullet->CalcAngles(rotate_angle + mCorrectAngle);
+    bullet->mId = mSim.Fire(bullet->mType->mDesc, sim::Vec2{ init_point.x, init_point.y }, rotate_angle + mCorrectAngle, mInvert);
     bullet->mFirstDraw = true;
-    mUsedBulletPool.push_back(std::move(bullet));
+    mUsedBullets.push_back(index);
     mShotTimer.Start();
     return true;
 }
@@ -432,5 +339,5 @@ size_t MachineGun::BulletsCount()
         mIsRecharged = false;
     }
 
-    return mBulletPool.size(); 
+    return mMagazine.size(); 
 }
\ No newline at end of file
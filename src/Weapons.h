@@ -6,21 +6,12 @@
  * \author Maksimovskiy A.S.
  */
 
-#include <memory>
-#include <list>
+#include <vector>
 
-#include "ObjectsForShot.h"
-
-// Dimension of arrays for the Runge - Kutta formula
-const int N_DIM = 4;
-
-// Bullet damage type
-enum class Damage
-{
-    SMALL = 15,
-    MIDDLE = 30,
-    LARGE = 45
-};
+#include "AudioEvents.h"
+#include "EffectPool.h"
+#include "SpriteRenderer.h"
+#include "sim/SimThread.h"
 
 // Angle adjustment. Depends on the inclination of the cannon on the texture.
 enum class AngleCorrect
@@ -41,54 +32,12 @@ struct Aim
 
 using shared_tex = Render::Texture*;
 
-// Base structure to describe the bullet
-struct Bullet
+// Attributes shared by all bullets of one kind. They are calculated once, not for each bullet.
+struct BulletPrototype
 {
-    Bullet();
-    
-    // Calculation of the angle of rotation of the bullet and the initial coordinates
-    void CalcAngles(float rotate_angle);
-    
-    // Method for simple drawing of a bullet
-    void SimpleDraw();
-    
-    // Bullet drawing.
-    // Accepts a link to the object vector object.
-    void Draw(ObjectsPool& shot_objects);
-    
-    // Draw all effects
-    void DrawEffects(EffectsContainer& eff_cont);
-    
-    // Draw ammo indicator
-    void DrawBulletIndicator();
-    
     // Bullet texture
     shared_tex mTexture;
     
-    // Inversion flag.
-    // Required to adjust the angle of the bullet and drawing.
-    bool mInvert;
-    
-    // The flag is responsible for the use of bullet.
-    // If a bullet hit the target, it is used.
-    bool mIsUsed;
-    
-    // Bullet current position
-    FPoint mCurrentPoint;
-    FPoint mTargetPoint;
-    
-    // Tilt angle at which the bullet shot
-    float mSystemAngle;
-    
-    // Bullet fly effect
-    ParticleEffectPtr mFlyEffect;
-    
-    // Bullet hit effect
-    ParticleEffectPtr mHitEffect;
-    
-    // Flag denoting the moment of a bullet shot
-    bool mFirstDraw;
-protected:
     // Bullet indicator texture
     shared_tex mOneBulletTexture;
     
@@ -96,42 +45,75 @@ protected:
     float mDeltaX;
     float mDeltaY;
     
-    // Bullet velocity
-    int mVelocity;
+    // Attributes of the bullet for the simulation
+    sim::BulletDesc mDesc;
+};
+
+// Attributes of the bullets used in pistols
+BulletPrototype MakePistolPrototype();
+
+// Base structure to describe the bullet.
+// The flight of the bullet is calculated in the simulation, the structure is responsible for its drawing.
+struct Bullet
+{
+    // Preparing the bullet of the kind for a new shot
+    void Reset(const BulletPrototype* type);
     
-    // Approximate bullet size
-    int mSize;
+    // Method for simple drawing of a bullet in the current state.
+    // Alpha is the share of the next simulation step passed since the last one.
+    void SimpleDraw(const sim::Bullet& state, float alpha, SpriteRenderer& sprites);
     
-    // Bullet damage
-    Damage mDamage;
+    // Draw all effects
+    void DrawEffects(const sim::Bullet& state, float alpha, EffectPool& effects);
+    
+    // Kind of the bullet
+    const BulletPrototype* mType;
     
-    // Drag param
-    float mCm;
+    // Identifier of the fired bullet in the simulation
+    uint32_t mId;
     
-    // Swift param
-    float mKm;
-    private:
-    // Array to store data about the previous position of the bullet
-    float mXYold[N_DIM];
+    // Bullet current position
+    FPoint mCurrentPoint;
+    FPoint mTargetPoint;
     
-    // Function to calculate the coefficients by the method of Runge - Kutta
-    float* RKFunc(float* xy_old);
+    // Bullet fly effect. The shot and the hit are played by the pool once.
+    EffectHandle mTrail;
     
-    // Bullet movement method
-    void Move();
+    // Flag denoting the moment of a bullet shot
+    bool mFirstDraw;
 };
 
-// Kind of bullets used in pistols
-struct PistolBullet : public Bullet
+// Storage of all bullets of the gun created at once.
+// The spent bullets return to the list of free ones, so the shots and reloads don't allocate memory.
+class BulletPool
 {
-    PistolBullet();
+public:
+    // Index meaning that there is no free bullet
+    static const uint32_t NO_BULLET = static_cast<uint32_t>(-1);
+
+    // Creating capacity free bullets. All previous bullets become free.
+    void Init(size_t capacity);
+
+    // Index of a free bullet or NO_BULLET if all bullets are in use
+    uint32_t Acquire();
+
+    // Returning the spent bullet to the free ones
+    void Release(uint32_t index);
+
+    Bullet& operator[](uint32_t index) { return mBullets[index]; }
+
+    size_t Capacity() const { return mBullets.size(); }
+private:
+    sim::BulletArray<Bullet> mBullets;
+    // Indices of the free bullets
+    sim::BulletArray<uint32_t> mFree;
 };
 
 // Weapon description class
 class MachineGun
 {
 public:
-    MachineGun();
+    MachineGun(sim::SimThread& sim, AudioEvents& audio);
     
     // Initialization of bullets in the store
     void InitBullets(bool restart = false, bool recharge = false);
@@ -140,7 +122,7 @@ public:
     void Draw();
     
     // Drawing all bullets fired
-    void BulletsDraw(ObjectsPool& shot_objects, EffectsContainer& eff_cont);
+    void BulletsDraw(EffectPool& effects, SpriteRenderer& sprites);
     void DrawOneBullet(float x, float y);
     
     // Gun shot method
@@ -153,6 +135,11 @@ public:
     // Bullets count in the gun store
     size_t BulletsCount();
 private:
+    // Simulation of the bullets flight
+    sim::SimThread& mSim;
+    // Sounds of the shots and recharges
+    AudioEvents& mAudio;
+    
     // Gun texture
     Render::Texture* mTexture;
     // Recharge message texture
@@ -160,13 +147,14 @@ private:
     // Gun aim
     Aim mAim;
     
-    // Bullets array.
-    using bullet_ptr = std::unique_ptr<Bullet>;
-    std::vector<bullet_ptr> mBulletPool;
-    // Used bullets
-    std::vector<bullet_ptr> mUsedBulletPool;
-    // One bullet for drawing indicator
-    bullet_ptr mOneBullet;
+    // Attributes of the pistol bullets
+    BulletPrototype mPistol;
+    // All bullets of the gun
+    BulletPool mBulletPool;
+    // Indices of the bullets in the store
+    sim::BulletArray<uint32_t> mMagazine;
+    // Indices of the fired bullets in the order of the shots
+    sim::BulletArray<uint32_t> mUsedBullets;
     
     // Shot timer. The current gun shoots every 0.5 seconds.
     Core::Timer mShotTimer;
@@ -175,11 +163,6 @@ private:
     Core::Timer mRechargeTimer;
     bool mIsRecharged;
     
-    // Timer for calculating the flight time of the bullet
-    Core::Timer mWeaponTimer;
-    // Previous time to calculate bullet flight
-    float mPrevTime;
-    
     // Width of the main window
     int mWinWidth;
     
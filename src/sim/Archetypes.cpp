@@ -0,0 +1,224 @@
+/**
+ * \file
+ * \brief Implementation of the reading of the kinds of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "Archetypes.h"
+#include "XmlTags.h"
+
+namespace sim
+{
+    namespace
+    {
+        // Numeric attribute of the tag <target>: its name, the member and the range of the values
+        template <class T>
+        struct ArchetypeField
+        {
+            const char* mName;
+            T TargetArchetype::* mMember;
+            T mMin;
+            T mMax;
+        };
+
+        const ArchetypeField<int> INT_FIELDS[] =
+        {
+            { "hp", &TargetArchetype::mHP, 1, 1000000 },
+            { "count", &TargetArchetype::mCount, -1, 1000000 }
+        };
+
+        const ArchetypeField<float> FLOAT_FIELDS[] =
+        {
+            { "minSpeed", &TargetArchetype::mMinSpeed, 0.0f, 10000.0f },
+            { "maxSpeed", &TargetArchetype::mMaxSpeed, 0.0f, 10000.0f },
+            { "radius", &TargetArchetype::mRadius, 0.0f, 4096.0f }
+        };
+
+        // Attributes which aren't numbers
+        const char* TEXT_FIELDS[] = { "name", "texture", "movement" };
+
+        bool ParseValue(const std::string& text, int& value)
+        {
+            char* end = nullptr;
+            errno = 0;
+            long result = std::strtol(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || errno == ERANGE)
+                return false;
+            value = static_cast<int>(result);
+            return value == result;
+        }
+
+        bool ParseValue(const std::string& text, float& value)
+        {
+            char* end = nullptr;
+            errno = 0;
+            value = std::strtof(text.c_str(), &end);
+            return !text.empty() && *end == '\0' && errno != ERANGE;
+        }
+
+        template <class T, size_t N>
+        void SetFields(const ArchetypeField<T> (&fields)[N], const std::string& tag, TargetArchetype& archetype,
+                       std::vector<std::string>& errors)
+        {
+            for (auto& field : fields)
+            {
+                std::string text = TagAttribute(tag, field.mName);
+                if (text.empty())
+                    continue;
+
+                T value;
+                if (!ParseValue(text, value))
+                    errors.push_back(archetype.mName + ": wrong " + field.mName + " " + text);
+                else if (value < field.mMin || value > field.mMax)
+                    errors.push_back(archetype.mName + ": " + field.mName + " " + text + " is out of range");
+                else
+                    archetype.*field.mMember = value;
+            }
+        }
+
+        template <class T, size_t N>
+        bool HasField(const ArchetypeField<T> (&fields)[N], const std::string& name)
+        {
+            for (auto& field : fields)
+            {
+                if (name == field.mName)
+                    return true;
+            }
+            return false;
+        }
+
+        bool IsKnown(const std::string& name)
+        {
+            for (auto field : TEXT_FIELDS)
+            {
+                if (name == field)
+                    return true;
+            }
+            return HasField(INT_FIELDS, name) || HasField(FLOAT_FIELDS, name);
+        }
+
+        // Checking that the tag has only the known attributes, so a typo isn't silently ignored
+        void CheckNames(const std::string& tag, const std::string& archetype, std::vector<std::string>& errors)
+        {
+            for (auto& name : TagAttributeNames(tag))
+            {
+                if (!IsKnown(name))
+                    errors.push_back(archetype + ": unknown attribute " + name);
+            }
+        }
+    }
+
+    bool ParseArchetypes(const std::string& xml, std::vector<TargetArchetype>& archetypes,
+                         std::vector<std::string>& errors)
+    {
+        std::vector<TargetArchetype> result;
+        size_t first_error = errors.size();
+        for (auto& tag : FindTags(xml, "target", errors))
+        {
+            TargetArchetype archetype;
+            archetype.mName = TagAttribute(tag, "name");
+            archetype.mTexture = TagAttribute(tag, "texture");
+            if (archetype.mName.empty())
+            {
+                errors.push_back("Target without a name");
+                continue;
+            }
+
+            CheckNames(tag, archetype.mName, errors);
+            if (archetype.mTexture.empty())
+                errors.push_back(archetype.mName + ": no texture");
+
+            std::string movement = TagAttribute(tag, "movement");
+            if (movement == "nonlinear")
+                archetype.mMovement = Movement::NONLINEAR;
+            else if (!movement.empty() && movement != "linear")
+                errors.push_back(archetype.mName + ": wrong movement " + movement);
+
+            SetFields(INT_FIELDS, tag, archetype, errors);
+            SetFields(FLOAT_FIELDS, tag, archetype, errors);
+            if (archetype.mMinSpeed > archetype.mMaxSpeed)
+                errors.push_back(archetype.mName + ": minSpeed is greater than maxSpeed");
+
+            for (auto& other : result)
+            {
+                if (other.mName == archetype.mName)
+                    errors.push_back(archetype.mName + ": repeated name");
+            }
+            result.push_back(archetype);
+        }
+
+        if (result.empty())
+            errors.push_back("No targets");
+        // The index of the kind is kept by each target in 16 bits
+        else if (result.size() > std::numeric_limits<uint16_t>::max())
+            errors.push_back("Too many targets");
+
+        if (errors.size() != first_error)
+            return false;
+
+        archetypes.swap(result);
+        return true;
+    }
+
+    std::vector<int> SplitTargetCount(const std::vector<TargetArchetype>& archetypes, int total)
+    {
+        std::vector<int> counts(archetypes.size(), 0);
+        int rest = std::max(total, 0);
+        int shared = 0;
+        for (size_t i = 0; i < archetypes.size(); i++)
+        {
+            if (archetypes[i].mCount < 0)
+            {
+                shared++;
+                continue;
+            }
+
+            counts[i] = std::min(archetypes[i].mCount, rest);
+            rest -= counts[i];
+        }
+
+        if (shared == 0)
+            return counts;
+
+        // The first kinds get one target more if the rest isn't divided equally
+        int share = rest / shared;
+        int extra = rest % shared;
+        for (size_t i = 0; i < archetypes.size(); i++)
+        {
+            if (archetypes[i].mCount >= 0)
+                continue;
+
+            counts[i] = share;
+            if (extra > 0)
+            {
+                counts[i]++;
+                extra--;
+            }
+        }
+        return counts;
+    }
+
+    TargetDesc MakeTargetDesc(const TargetArchetype& archetype, size_t index, int width, int height)
+    {
+        TargetDesc desc;
+        desc.mArchetype = static_cast<uint16_t>(index);
+        desc.mMovement = archetype.mMovement;
+        desc.mDeltaX = width * 0.5f;
+        desc.mDeltaY = height * 0.5f;
+        desc.mHP = archetype.mHP;
+        desc.mMinSpeed = archetype.mMinSpeed;
+        desc.mMaxSpeed = archetype.mMaxSpeed;
+
+        // By default it is the whole radius of a circle describing the texture
+        desc.mRadius = archetype.mRadius;
+        if (desc.mRadius <= 0.0f)
+            desc.mRadius = std::floor(std::sqrt(desc.mDeltaX * desc.mDeltaX + desc.mDeltaY * desc.mDeltaY));
+        return desc;
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Kinds of the targets described by Targets.xml
+ * \author Maksimovskiy A.S.
+ */
+
+#include <string>
+#include <vector>
+
+#include "Targets.h"
+
+namespace sim
+{
+    // Kind of the targets. Each one is set by the tag <target .../> of Targets.xml.
+    struct TargetArchetype
+    {
+        // Name of the kind
+        std::string mName;
+
+        // Name of the texture in Resources.xml
+        std::string mTexture;
+
+        // Hit points
+        int mHP = 20;
+
+        // Range of the initial velocity projections
+        float mMinSpeed = 10.0f;
+        float mMaxSpeed = 30.0f;
+
+        Movement mMovement = Movement::LINEAR;
+
+        // Size. If it is 0, the size is calculated by the texture.
+        float mRadius = 0.0f;
+
+        // Count of the targets of the kind in the round. If it is -1, the kind shares the targets left by the others.
+        int mCount = -1;
+    };
+
+    // Reading the kinds of the targets from the tags <target .../> in the order of the file.
+    // Unknown attributes, wrong values and repeated names are added to errors,
+    // the kinds are changed only if there are no errors.
+    bool ParseArchetypes(const std::string& xml, std::vector<TargetArchetype>& archetypes,
+                         std::vector<std::string>& errors);
+
+    // Count of the targets of each kind for the total count.
+    // The kinds with a count take their targets first in the order of the file,
+    // the other kinds share the rest equally.
+    std::vector<int> SplitTargetCount(const std::vector<TargetArchetype>& archetypes, int total);
+
+    // Attributes of the targets of the kind with the index for the texture of the size width x height
+    TargetDesc MakeTargetDesc(const TargetArchetype& archetype, size_t index, int width, int height);
+}
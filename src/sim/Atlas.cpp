@@ -0,0 +1,145 @@
+/**
+ * \file
+ * \brief Implementation of the packing of the images into the atlas
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "Atlas.h"
+
+namespace sim
+{
+    namespace
+    {
+        // Placing the images by rows into the atlas of the size. The regions are changed only if all images fit.
+        bool PackRows(std::vector<AtlasRegion>& regions, const std::vector<size_t>& order,
+                      int width, int height, int padding)
+        {
+            std::vector<AtlasRegion> placed = regions;
+            int x = 0;
+            int y = 0;
+            int row_height = 0;
+            for (size_t index : order)
+            {
+                AtlasRegion& region = placed[index];
+                int cell_width = region.mWidth + 2 * padding;
+                int cell_height = region.mHeight + 2 * padding;
+                if (cell_width > width)
+                    return false;
+
+                // The next row starts under the highest image of the current one
+                if (x + cell_width > width)
+                {
+                    x = 0;
+                    y += row_height;
+                    row_height = 0;
+                }
+
+                if (y + cell_height > height)
+                    return false;
+
+                region.mX = x + padding;
+                region.mY = y + padding;
+                x += cell_width;
+                row_height = std::max(row_height, cell_height);
+            }
+
+            regions.swap(placed);
+            return true;
+        }
+    }
+
+    const AtlasRegion* AtlasTable::Find(const std::string& name) const
+    {
+        for (auto& region : mRegions)
+        {
+            if (region.mName == name)
+                return &region;
+        }
+
+        return nullptr;
+    }
+
+    bool PackAtlas(AtlasTable& table, int max_size, int padding)
+    {
+        auto& regions = table.mRegions;
+        std::vector<size_t> order(regions.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+
+        // The rows are denser if the images of one row have close heights
+        std::stable_sort(order.begin(), order.end(), [&](size_t first, size_t second)
+        {
+            return regions[first].mHeight > regions[second].mHeight;
+        });
+
+        // Sizes of the atlas in the order of increasing area. The wide atlas goes first for the same area.
+        std::vector<std::pair<int, int>> sizes;
+        for (int width = 1; width <= max_size; width *= 2)
+        {
+            for (int height = 1; height <= width; height *= 2)
+                sizes.emplace_back(width, height);
+        }
+        std::stable_sort(sizes.begin(), sizes.end(), [](const std::pair<int, int>& first, const std::pair<int, int>& second)
+        {
+            return first.first * first.second < second.first * second.second;
+        });
+
+        for (auto& size : sizes)
+        {
+            if (PackRows(regions, order, size.first, size.second, padding))
+            {
+                table.mWidth = size.first;
+                table.mHeight = size.second;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::string FormatAtlasTable(const AtlasTable& table)
+    {
+        std::ostringstream out;
+        out << "# Made by war_atlas. Places of the images in pixels from the top left corner: name x y width height\n";
+        out << "atlas " << table.mPath << ' ' << table.mWidth << ' ' << table.mHeight << '\n';
+        for (auto& region : table.mRegions)
+            out << region.mName << ' ' << region.mX << ' ' << region.mY << ' ' << region.mWidth << ' ' << region.mHeight << '\n';
+        return out.str();
+    }
+
+    bool ParseAtlasTable(const std::string& text, AtlasTable& table)
+    {
+        table = AtlasTable{ std::string(), 0, 0, {} };
+        bool has_header = false;
+
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream fields(line);
+            if (!has_header)
+            {
+                std::string keyword;
+                if (!(fields >> keyword >> table.mPath >> table.mWidth >> table.mHeight) || keyword != "atlas")
+                    return false;
+                has_header = true;
+                continue;
+            }
+
+            AtlasRegion region;
+            if (!(fields >> region.mName >> region.mX >> region.mY >> region.mWidth >> region.mHeight))
+                return false;
+            table.mRegions.push_back(region);
+        }
+
+        return has_header && table.mWidth > 0 && table.mHeight > 0;
+    }
+}
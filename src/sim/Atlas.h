@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Layout of the images packed into one texture and its table
+ * \author Maksimovskiy A.S.
+ */
+
+#include <string>
+#include <vector>
+
+namespace sim
+{
+    // Place of one image in the atlas. The coordinates are in pixels from the top left corner of the atlas.
+    struct AtlasRegion
+    {
+        // Name of the texture in Resources.xml
+        std::string mName;
+
+        int mX;
+        int mY;
+        int mWidth;
+        int mHeight;
+    };
+
+    // Size of the atlas and the places of all images in it
+    struct AtlasTable
+    {
+        // Path of the atlas image without the extension, as in Resources.xml
+        std::string mPath;
+
+        int mWidth;
+        int mHeight;
+
+        std::vector<AtlasRegion> mRegions;
+
+        // Region of the image by its name or nullptr
+        const AtlasRegion* Find(const std::string& name) const;
+    };
+
+    // Placing the images given by the names and sizes of the regions into the smallest atlas
+    // with the sides of powers of two not greater than max_size.
+    // The images are placed by rows in the order of decreasing height, padding pixels are left around each of them.
+    // Returns false if the images don't fit.
+    bool PackAtlas(AtlasTable& table, int max_size, int padding);
+
+    // Text form of the table: the line "atlas <path> <width> <height>" and a line "<name> <x> <y> <width> <height>"
+    // for each image. Empty lines and lines starting with '#' are skipped.
+    std::string FormatAtlasTable(const AtlasTable& table);
+
+    // Reading the table from the text form. Returns false if the text isn't a table.
+    bool ParseAtlasTable(const std::string& text, AtlasTable& table);
+}
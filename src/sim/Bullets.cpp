@@ -0,0 +1,296 @@
+/**
+ * \file
+ * \brief Implementation of the bullets physics
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cmath>
+
+#include "Bullets.h"
+#include "Profiler.h"
+#include "Targets.h"
+#include "Trig.h"
+
+namespace sim
+{
+    // Acceleration of gravity
+    const float G = 9.81f;
+    // Air resistance (kg / m ^ 3)
+    const float RHO = 1.23f;
+    // Height below which the bullet is on the ground
+    const float GROUND_Y = -0.001f;
+
+    namespace
+    {
+        // Right part of the bullet movement equations for the state (x, vx, y, vy).
+        // Only the velocity changes are calculated, the coordinates change by the velocities.
+        inline void RKFunc(float cm, float km, float vx, float vy, float& ax, float& ay)
+        {
+            // Vx change
+            ax = -cm * vx - km * vy;
+            // Vy change
+            ay = -G - cm * vy + km * vx;
+        }
+
+        // One step of the RK4 method for count bullets. The step of a bullet is multiplied by its share in moving.
+        // The loop has no branches and calls and the arrays don't overlap,
+        // so the compiler processes several bullets per instruction.
+        void IntegrateRK4(float* __restrict x, float* __restrict vx, float* __restrict y, float* __restrict vy,
+                          const float* __restrict cm, const float* __restrict km, const float* __restrict moving,
+                          size_t count, float dt)
+        {
+            const float half_dt = 0.5f * dt;
+            const float sixth_dt = dt / 6.0f;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                float x0 = x[i];
+                float vx0 = vx[i];
+                float y0 = y[i];
+                float vy0 = vy[i];
+                float c = cm[i];
+                float k = km[i];
+
+                // k1 = f(tn, yn)
+                float ax1, ay1;
+                RKFunc(c, k, vx0, vy0, ax1, ay1);
+
+                // k2 = f(tn + h/2, yn + k1/2)
+                float vx1 = vx0 + half_dt * ax1;
+                float vy1 = vy0 + half_dt * ay1;
+                float ax2, ay2;
+                RKFunc(c, k, vx1, vy1, ax2, ay2);
+
+                // k3 = f(tn + h/2, yn + k2/2)
+                float vx2 = vx0 + half_dt * ax2;
+                float vy2 = vy0 + half_dt * ay2;
+                float ax3, ay3;
+                RKFunc(c, k, vx2, vy2, ax3, ay3);
+
+                // k4 = f(tn + h, yn + k3)
+                float vx3 = vx0 + dt * ax3;
+                float vy3 = vy0 + dt * ay3;
+                float ax4, ay4;
+                RKFunc(c, k, vx3, vy3, ax4, ay4);
+
+                float step = sixth_dt * moving[i];
+                x[i] = x0 + step * (vx0 + 2.0f * vx1 + 2.0f * vx2 + vx3);
+                vx[i] = vx0 + step * (ax1 + 2.0f * ax2 + 2.0f * ax3 + ax4);
+                y[i] = y0 + step * (vy0 + 2.0f * vy1 + 2.0f * vy2 + vy3);
+                vy[i] = vy0 + step * (ay1 + 2.0f * ay2 + 2.0f * ay3 + ay4);
+            }
+        }
+    }
+
+    BulletDesc MakePistolBullet(float speed, int size)
+    {
+        BulletDesc desc;
+        desc.mSpeed = speed;
+        desc.mSize = size;
+        desc.mDamage = static_cast<int>(Damage::SMALL);
+
+        // Angular velocity
+        float rpm = 5.0f;
+        // Convert to rad/s
+        float w = rpm * PI / 30.0f;
+        // Cross sectional area in m ^ 2
+        float S = 0.0021f;
+        // Bullet mass in kg
+        float m = 0.018f;
+
+        // Drag coefficient
+        float CD = 0.30f + 2.58e-4f * w;
+        desc.mCm = 0.5f * CD * S * RHO / m;
+
+        // Swift factor
+        float CL = 0.3187f * (1.0f - std::exp(-2.483e-3f * w));
+        desc.mKm = 0.5f * CL * S * RHO / m;
+        return desc;
+    }
+
+    void BulletSystem::Resize(size_t size)
+    {
+        mId.resize(size);
+        mX.resize(size);
+        mVx.resize(size);
+        mY.resize(size);
+        mVy.resize(size);
+        mPrevX.resize(size);
+        mPrevY.resize(size);
+        mCm.resize(size);
+        mKm.resize(size);
+        mSystemAngle.resize(size);
+        mInvert.resize(size);
+        mIsUsed.resize(size);
+        mSize.resize(size);
+        mDamage.resize(size);
+    }
+
+    void BulletSystem::Reserve(size_t count)
+    {
+        mId.reserve(count);
+        mX.reserve(count);
+        mVx.reserve(count);
+        mY.reserve(count);
+        mVy.reserve(count);
+        mPrevX.reserve(count);
+        mPrevY.reserve(count);
+        mCm.reserve(count);
+        mKm.reserve(count);
+        mSystemAngle.reserve(count);
+        mInvert.reserve(count);
+        mIsUsed.reserve(count);
+        mSize.reserve(count);
+        mDamage.reserve(count);
+        mMoving.reserve(count);
+    }
+
+    void BulletSystem::Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert)
+    {
+        float sin_angle, cos_angle;
+        SinCosDeg(rotate_angle, sin_angle, cos_angle);
+        float dir = invert ? -1.0f : 1.0f;
+
+        size_t i = Size();
+        Resize(i + 1);
+        mId[i] = id;
+        // Initial position, initial speed, shot angle
+        mX[i] = point.x;
+        mVx[i] = desc.mSpeed * cos_angle * dir;
+        mY[i] = point.y;
+        mVy[i] = desc.mSpeed * sin_angle * dir;
+        mPrevX[i] = point.x;
+        mPrevY[i] = point.y;
+        mCm[i] = desc.mCm;
+        mKm[i] = desc.mKm;
+        mSystemAngle[i] = rotate_angle;
+        mInvert[i] = invert;
+        mIsUsed[i] = false;
+        mSize[i] = desc.mSize;
+        mDamage[i] = desc.mDamage;
+    }
+
+    void BulletSystem::Integrate(float dt)
+    {
+        PROFILE_ZONE("BulletIntegrate");
+        /**
+        * The movement of the bullet is calculated as for an object launched at an angle to the horizon.
+        * But in addition to the action of gravity, factors such as
+        * air resistance, angular velocity and wind action are also taken into account.
+        * From the second law of Newton a = F / m, whence it follows that
+        * d^2(x)/dt^2 = dvx/dt = (-(c/m) * vx - (k/m) * vy) * sqrt(vx * vx + vy * vy)
+        * d^2(y)/dt^2 = dvy/dt = ((k/m) * vx - (c/m) * vy) * sqrt(vx * vx + vy * vy) - g ,
+        * where c = (1/2) * Cd * A * ro, k = (1/2) * Cl * A * ro.
+        * c is the drag coefficient due to air resistance,
+        * k - offset factor due to angular velocity and wind
+        * A - the cross-sectional area of the bullet (or any other object)
+        * ro - air resistance
+        * Cd - deceleration parameter, Cl - offset parameter
+        * Cd = 0.30 + (2.58 * 10^(-4)) * w
+        * Cl = 0.319 * (1 - exp(-2.48 * 10^(-3) * w)), where w is the angular velocity in rad / s
+        *
+        * Further, the RK4 method is used - one of the Runge-Kutta family of numerical methods.
+        * At each step n and at time iteration dt, it turns out
+        * xy[n+1] = xy[n] + (1/6) * (k1 + 2*k2 + 2*k3 + k4), where
+        * k1 = dt * RK4(xy[n])
+        * k2 = dt * RK4(xy[n] + k1 / 2)
+        * k3 = dt * RK4(xy[n] + k2 / 2)
+        * k4 = dt * RK4(xy[n] + k3)
+        *
+        * xy - at each iteration n, this is an array of 4 elements:
+        * current x and y coordinates and velocity projections vx and vy
+        */
+        // If the bullet did not hit one target,
+        // it is considered used when it hits the ground. Used bullets don't move.
+        mPrevX = mX;
+        mPrevY = mY;
+        mMoving.resize(Size());
+        for (size_t i = 0; i < Size(); i++)
+        {
+            mIsUsed[i] |= mY[i] < GROUND_Y;
+            mMoving[i] = mIsUsed[i] ? 0.0f : 1.0f;
+        }
+
+        IntegrateRK4(mX.data(), mVx.data(), mY.data(), mVy.data(), mCm.data(), mKm.data(),
+                     mMoving.data(), Size(), dt);
+    }
+
+    void BulletSystem::Move(float dt, TargetSystem& targets)
+    {
+        Integrate(dt);
+
+        PROFILE_ZONE("BulletHits");
+        for (size_t i = 0; i < Size(); i++)
+        {
+            if (mIsUsed[i])
+                continue;
+
+            // Check for hit on any of the objects
+            if (targets.CheckHit(Vec2{ mX[i], mY[i] }, mSize[i], mVx[i], mVy[i], mDamage[i]))
+                mIsUsed[i] = true;
+        }
+    }
+
+    Bullet BulletSystem::Get(size_t index) const
+    {
+        Bullet bullet;
+        bullet.mId = mId[index];
+        bullet.mXY[0] = mX[index];
+        bullet.mXY[1] = mVx[index];
+        bullet.mXY[2] = mY[index];
+        bullet.mXY[3] = mVy[index];
+        bullet.mPrevX = mPrevX[index];
+        bullet.mPrevY = mPrevY[index];
+        bullet.mSystemAngle = mSystemAngle[index];
+        bullet.mInvert = mInvert[index] != 0;
+        bullet.mIsUsed = mIsUsed[index] != 0;
+        bullet.mSize = mSize[index];
+        bullet.mDamage = mDamage[index];
+        bullet.mCm = mCm[index];
+        bullet.mKm = mKm[index];
+        return bullet;
+    }
+
+    void BulletSystem::MoveSlot(size_t from, size_t to)
+    {
+        mId[to] = mId[from];
+        mX[to] = mX[from];
+        mVx[to] = mVx[from];
+        mY[to] = mY[from];
+        mVy[to] = mVy[from];
+        mPrevX[to] = mPrevX[from];
+        mPrevY[to] = mPrevY[from];
+        mCm[to] = mCm[from];
+        mKm[to] = mKm[from];
+        mSystemAngle[to] = mSystemAngle[from];
+        mInvert[to] = mInvert[from];
+        mIsUsed[to] = mIsUsed[from];
+        mSize[to] = mSize[from];
+        mDamage[to] = mDamage[from];
+    }
+
+    void BulletSystem::DeleteUsed(BulletArray<Bullet>& retired)
+    {
+        PROFILE_ZONE("BulletDeleteUsed");
+        size_t kept = 0;
+        for (size_t i = 0; i < Size(); i++)
+        {
+            if (mIsUsed[i])
+            {
+                retired.push_back(Get(i));
+                continue;
+            }
+
+            if (kept != i)
+                MoveSlot(i, kept);
+            kept++;
+        }
+
+        Resize(kept);
+    }
+
+    void BulletSystem::Clear()
+    {
+        Resize(0);
+    }
+}
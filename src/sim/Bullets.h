@@ -0,0 +1,166 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Headless state and physics of the bullets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "Memory.h"
+#include "SimTypes.h"
+
+namespace sim
+{
+    class TargetSystem;
+
+    // Array of an attribute of the bullets
+    template <class T>
+    using BulletArray = TrackedVector<T, MemTag::BULLETS>;
+
+    // Dimension of arrays for the Runge - Kutta formula
+    const int N_DIM = 4;
+
+    // Bullet damage type
+    enum class Damage
+    {
+        SMALL = 15,
+        MIDDLE = 30,
+        LARGE = 45
+    };
+
+    // Attributes shared by all bullets of one kind
+    struct BulletDesc
+    {
+        // Bullet velocity
+        float mSpeed;
+
+        // Approximate bullet size
+        int mSize;
+
+        // Bullet damage
+        int mDamage;
+
+        // Drag param
+        float mCm;
+
+        // Swift param
+        float mKm;
+    };
+
+    // Attributes of the bullet used in pistols
+    BulletDesc MakePistolBullet(float speed, int size);
+
+    // State of one bullet in flight
+    struct Bullet
+    {
+        // Unique identifier of the shot
+        uint32_t mId;
+
+        // Current position and velocity projections: x, vx, y, vy
+        float mXY[N_DIM];
+
+        // Position before the last step
+        float mPrevX;
+        float mPrevY;
+
+        // Tilt angle at which the bullet shot
+        float mSystemAngle;
+
+        // Inversion flag.
+        // Required to adjust the angle of the bullet and drawing.
+        bool mInvert;
+
+        // The flag is responsible for the use of bullet.
+        // If a bullet hit the target or the ground, it is used.
+        bool mIsUsed;
+
+        // Approximate bullet size
+        int mSize;
+
+        // Bullet damage
+        int mDamage;
+
+        // Drag param
+        float mCm;
+
+        // Swift param
+        float mKm;
+
+        Vec2 Point() const { return Vec2{ mXY[0], mXY[2] }; }
+
+        // Position between the previous and the current one. Alpha is the share of the last step.
+        Vec2 Point(float alpha) const
+        {
+            return Vec2{ mPrevX + (mXY[0] - mPrevX) * alpha, mPrevY + (mXY[2] - mPrevY) * alpha };
+        }
+    };
+
+    // Storage and physics of all bullets in flight.
+    // Each attribute of the bullets is stored in a separate array in the order of the shots.
+    class BulletSystem
+    {
+    public:
+        // Shot of a new bullet from the point at an angle in degrees.
+        // Identifiers must increase in the order of the shots.
+        void Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert);
+
+        // Movement of all bullets and checking their hit with the targets
+        void Move(float dt, TargetSystem& targets);
+
+        // Movement of all bullets by one step of the RK4 method in one pass over the arrays.
+        // A bullet below the ground becomes used instead of moving, used bullets don't move.
+        // The positions before the step are kept.
+        void Integrate(float dt);
+
+        // Method to remove all used bullets. The removed bullets are added to the retired vector.
+        // The order of the remaining bullets doesn't change.
+        void DeleteUsed(BulletArray<Bullet>& retired);
+
+        // State of the bullet by its index
+        Bullet Get(size_t index) const;
+
+        // Identifiers of the bullets in the order of the shots
+        const BulletArray<uint32_t>& Ids() const { return mId; }
+
+        size_t Size() const { return mId.size(); }
+
+        // Reserving the memory for count bullets, so the shots up to them don't allocate
+        void Reserve(size_t count);
+
+        size_t Capacity() const { return mId.capacity(); }
+
+        void Clear();
+    private:
+        // Moving the bullet from the index from to the index to
+        void MoveSlot(size_t from, size_t to);
+
+        void Resize(size_t size);
+
+        BulletArray<uint32_t> mId;
+
+        // Current position and velocity projections
+        BulletArray<float> mX;
+        BulletArray<float> mVx;
+        BulletArray<float> mY;
+        BulletArray<float> mVy;
+
+        // Position before the last step
+        BulletArray<float> mPrevX;
+        BulletArray<float> mPrevY;
+
+        // Drag and swift params
+        BulletArray<float> mCm;
+        BulletArray<float> mKm;
+
+        BulletArray<float> mSystemAngle;
+        BulletArray<uint8_t> mInvert;
+        BulletArray<uint8_t> mIsUsed;
+        BulletArray<int> mSize;
+        BulletArray<int> mDamage;
+
+        // Share of the step made by the bullet on the integration: 0 for the used bullets
+        BulletArray<float> mMoving;
+    };
+}
@@ -0,0 +1,227 @@
+/**
+ * \file
+ * \brief Implementation of the reading of the game parameters
+ * \author Maksimovskiy A.S.
+ */
+
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#include "Config.h"
+
+namespace sim
+{
+    namespace
+    {
+        // Parameter of GameConfig: its name in input.txt, the member and the range of the values
+        template <class T>
+        struct ConfigField
+        {
+            const char* mName;
+            T GameConfig::* mMember;
+            T mMin;
+            T mMax;
+        };
+
+        const ConfigField<int> INT_FIELDS[] =
+        {
+            { "Width", &GameConfig::mWidth, 1, 8192 },
+            { "Height", &GameConfig::mHeight, 1, 8192 },
+            { "CountTarget", &GameConfig::mCountTarget, 0, 100000 },
+            { "Waves", &GameConfig::mWaves, 1, 100000 },
+            { "SpawnBudget", &GameConfig::mSpawnBudget, 1, 100000 },
+            { "MaxTargets", &GameConfig::mMaxTargets, 1, 1000000 },
+            { "Time", &GameConfig::mTime, 1, 86400 },
+            { "BulletCount", &GameConfig::mBulletCount, 0, 100000 },
+            { "TickRate", &GameConfig::mTickRate, 1, 1000 },
+            { "MaxTicks", &GameConfig::mMaxTicks, 1, 100 },
+            { "Threads", &GameConfig::mThreads, 1, 256 },
+            { "ParticleBudget", &GameConfig::mParticleBudget, 0, 1000000 },
+            { "ShotVoices", &GameConfig::mShotVoices, 1, 32 }
+        };
+
+        const ConfigField<float> FLOAT_FIELDS[] =
+        {
+            { "Speed", &GameConfig::mSpeed, 1.0f, 10000.0f },
+            { "WaveInterval", &GameConfig::mWaveInterval, 0.1f, 86400.0f },
+            { "TraceSeconds", &GameConfig::mTraceSeconds, 0.1f, 60.0f }
+        };
+
+        const ConfigField<bool> BOOL_FIELDS[] =
+        {
+            { "Record", &GameConfig::mRecord, false, true },
+            { "Endless", &GameConfig::mEndless, false, true },
+            { "Profile", &GameConfig::mProfile, false, true }
+        };
+
+        // The range of the strings isn't checked, they only must not be empty
+        const ConfigField<std::string> STRING_FIELDS[] =
+        {
+            { "RecordFile", &GameConfig::mRecordFile, std::string(), std::string() }
+        };
+
+        bool ParseValue(const std::string& text, int& value)
+        {
+            char* end = nullptr;
+            errno = 0;
+            long result = std::strtol(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || errno == ERANGE)
+                return false;
+            value = static_cast<int>(result);
+            return value == result;
+        }
+
+        bool ParseValue(const std::string& text, float& value)
+        {
+            char* end = nullptr;
+            errno = 0;
+            value = std::strtof(text.c_str(), &end);
+            return !text.empty() && *end == '\0' && errno != ERANGE;
+        }
+
+        bool ParseValue(const std::string& text, bool& value)
+        {
+            if (text == "1" || text == "true")
+                value = true;
+            else if (text == "0" || text == "false")
+                value = false;
+            else
+                return false;
+            return true;
+        }
+
+        bool ParseValue(const std::string& text, std::string& value)
+        {
+            value = text;
+            return !text.empty();
+        }
+
+        template <class T>
+        bool InRange(const ConfigField<T>& field, const T& value)
+        {
+            return value >= field.mMin && value <= field.mMax;
+        }
+
+        bool InRange(const ConfigField<std::string>&, const std::string&)
+        {
+            return true;
+        }
+
+        // Setting the parameter if it is in the fields. Returns false if there is no parameter with the name.
+        template <class T, size_t N>
+        bool SetField(const ConfigField<T> (&fields)[N], const std::string& name, const std::string& text,
+                      GameConfig& config, std::vector<std::string>& errors)
+        {
+            for (auto& field : fields)
+            {
+                if (name != field.mName)
+                    continue;
+
+                T value;
+                if (!ParseValue(text, value))
+                    errors.push_back(name + ": wrong value " + text);
+                else if (!InRange(field, value))
+                    errors.push_back(name + ": value " + text + " is out of range");
+                else
+                    config.*field.mMember = value;
+                return true;
+            }
+
+            return false;
+        }
+
+        std::string Trim(const std::string& text)
+        {
+            const char* spaces = " \t\r";
+            size_t begin = text.find_first_not_of(spaces);
+            if (begin == std::string::npos)
+                return std::string();
+            return text.substr(begin, text.find_last_not_of(spaces) - begin + 1);
+        }
+    }
+
+    bool ParseConfig(const std::string& text, GameConfig& config, std::vector<std::string>& errors,
+                     std::vector<std::string>* unknown)
+    {
+        GameConfig result;
+        size_t first_error = errors.size();
+        bool has_bullet_count = false;
+
+        // Each line is read separately.
+        // All characters before '=' are the name of the parameter, after - the value.
+        std::istringstream in(text);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            size_t separator = line.find('=');
+            if (separator == std::string::npos)
+            {
+                errors.push_back("wrong line: " + line);
+                continue;
+            }
+
+            std::string name = Trim(line.substr(0, separator));
+            std::string value = Trim(line.substr(separator + 1));
+            has_bullet_count |= name == "BulletCount";
+            bool known = SetField(INT_FIELDS, name, value, result, errors)
+                || SetField(FLOAT_FIELDS, name, value, result, errors)
+                || SetField(BOOL_FIELDS, name, value, result, errors)
+                || SetField(STRING_FIELDS, name, value, result, errors);
+            if (!known && unknown)
+                unknown->push_back(name);
+            else if (!known)
+                errors.push_back("unknown parameter " + name);
+        }
+
+        // A bullet for each target by default
+        if (!has_bullet_count)
+            result.mBulletCount = result.mCountTarget;
+
+        if (errors.size() != first_error)
+            return false;
+
+        config = result;
+        return true;
+    }
+
+    int HardwareThreads()
+    {
+        // The count is unknown on some systems
+        unsigned count = std::thread::hardware_concurrency();
+        return count > 0 ? static_cast<int>(count) : 1;
+    }
+
+    FileWatcher::FileWatcher(const std::string& path) :
+        mPath(path),
+        mTime(0),
+        mSize(-1),
+        mStarted(false)
+    {
+    }
+
+    bool FileWatcher::Changed()
+    {
+        struct stat info;
+        time_t time = 0;
+        long long size = -1;
+        if (stat(mPath.c_str(), &info) == 0)
+        {
+            time = info.st_mtime;
+            size = static_cast<long long>(info.st_size);
+        }
+
+        bool changed = mStarted && (time != mTime || size != mSize);
+        mTime = time;
+        mSize = size;
+        mStarted = true;
+        return changed;
+    }
+}
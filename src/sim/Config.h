@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Typed parameters of the game from input.txt
+ * \author Maksimovskiy A.S.
+ */
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace sim
+{
+    // Count of the threads of the processor, at least 1
+    int HardwareThreads();
+
+    // Parameters of the game. Each of them has a default value and is set by the line "Name=value" of input.txt.
+    struct GameConfig
+    {
+        // Screen size
+        int mWidth = 1024;
+        int mHeight = 768;
+
+        // Count of the targets of one wave
+        int mCountTarget = 20;
+
+        // Count of the waves of the targets and the time between their starts in seconds
+        int mWaves = 1;
+        float mWaveInterval = 10.0f;
+
+        // Endless mode: the waves don't end and the round has no time limit
+        bool mEndless = false;
+
+        // Maximum count of the targets spawned by one simulation step and of the live targets
+        int mSpawnBudget = 256;
+        int mMaxTargets = 5000;
+
+        // Initial speed of the bullets
+        float mSpeed = 128.0f;
+
+        // Time of the round in seconds
+        int mTime = 50;
+
+        // Count of the bullets in the gun. By default it is equal to the count of the targets.
+        int mBulletCount = 20;
+
+        // Maximum count of the live particles of the effects. The trails of the bullets become cheaper
+        // or are skipped when it is nearly reached.
+        int mParticleBudget = 2000;
+
+        // Maximum count of the shots heard at once. A new shot stops the oldest one.
+        int mShotVoices = 4;
+
+        // Count of the simulation steps per second and their maximum count for one frame
+        int mTickRate = 60;
+        int mMaxTicks = 5;
+
+        // Count of the threads for the interaction of the targets, including the simulation thread
+        int mThreads = HardwareThreads();
+
+        // Collection of the time of the zones of the code for the debug overlay
+        // and the length of the trace written by the 'P' key in seconds
+        bool mProfile = false;
+        float mTraceSeconds = 10.0f;
+
+        // Recording of the session to RecordFile
+        bool mRecord = false;
+        std::string mRecordFile = "session.rec";
+    };
+
+    // Reading the parameters from the lines "Name=value". The parameters that aren't in the text keep their defaults.
+    // Values of the wrong type and values out of their range are added to errors,
+    // the config is changed only if there are no errors. Unknown names are errors too if unknown is null,
+    // otherwise they are added to unknown and skipped, so the files with the retired parameters are still read.
+    bool ParseConfig(const std::string& text, GameConfig& config, std::vector<std::string>& errors,
+                     std::vector<std::string>* unknown = nullptr);
+
+    // Checking of the changes of a file on the disk by its modification time and size
+    class FileWatcher
+    {
+    public:
+        explicit FileWatcher(const std::string& path);
+
+        // Whether the file has changed since the last call. The first call remembers the state of the file.
+        bool Changed();
+    private:
+        std::string mPath;
+        // State of the file on the last call. The size is -1 if there is no file.
+        time_t mTime;
+        long long mSize;
+        bool mStarted;
+    };
+}
@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief Implementation of the slots of the particle effects
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdlib>
+
+#include "EffectBudget.h"
+#include "XmlTags.h"
+
+namespace sim
+{
+    bool ParseEffectCosts(const std::string& xml, std::vector<EffectCost>& costs, std::vector<std::string>& errors)
+    {
+        size_t error_count = errors.size();
+        std::vector<EffectCost> result;
+
+        // The particle systems of an effect are inside its element
+        for (auto& effect : FindElements(xml, "Effect", errors))
+        {
+            EffectCost cost{ TagAttribute(effect, "name"), 0 };
+            if (cost.mName.empty())
+            {
+                errors.push_back("effect without a name");
+                continue;
+            }
+
+            // The lines of the errors of the particle systems are counted from the effect
+            std::vector<std::string> system_errors;
+            auto systems = FindTags(effect, "ParticleSystem", system_errors);
+            for (auto& error : system_errors)
+                errors.push_back(cost.mName + ": " + error);
+
+            for (auto& system : systems)
+            {
+                std::string value = TagAttribute(system, "numOfParticles");
+                char* value_end = nullptr;
+                long particles = std::strtol(value.c_str(), &value_end, 10);
+                if (value.empty() || *value_end != '\0' || particles < 0 || particles > 1000000)
+                {
+                    errors.push_back(cost.mName + ": wrong numOfParticles \"" + value + "\"");
+                    continue;
+                }
+                cost.mParticles += static_cast<int>(particles);
+            }
+            result.push_back(cost);
+        }
+
+        if (errors.size() != error_count)
+            return false;
+
+        costs = result;
+        return true;
+    }
+
+    int FindEffectCost(const std::vector<EffectCost>& costs, const std::string& name)
+    {
+        for (auto& cost : costs)
+        {
+            if (cost.mName == name)
+                return cost.mParticles;
+        }
+        return -1;
+    }
+
+    const uint32_t EffectBudget::NO_SLOT;
+
+    EffectBudget::EffectBudget() :
+        mBudget(0),
+        mLive(0),
+        mTakes(0)
+    {
+    }
+
+    void EffectBudget::Init(int budget)
+    {
+        mKinds.clear();
+        mBudget = budget;
+        mLive = 0;
+        mTakes = 0;
+    }
+
+    size_t EffectBudget::AddKind(int particles)
+    {
+        // An effect without particles costs nothing, but it still needs a limit of its instances
+        size_t slots = static_cast<size_t>(mBudget / (particles > 0 ? particles : 1));
+
+        Kind kind;
+        kind.mParticles = particles;
+        kind.mOrder.assign(slots, 0);
+        kind.mFree.resize(slots);
+        // The slots are taken from the end, so the first ones are used first
+        for (size_t i = 0; i < slots; i++)
+            kind.mFree[i] = static_cast<uint32_t>(slots - 1 - i);
+
+        mKinds.push_back(kind);
+        return mKinds.size() - 1;
+    }
+
+    bool EffectBudget::Fits(int particles, float share) const
+    {
+        return mLive + particles <= static_cast<int>(mBudget * share);
+    }
+
+    uint32_t EffectBudget::Acquire(size_t kind)
+    {
+        auto& data = mKinds[kind];
+        if (data.mFree.empty() || !Fits(data.mParticles, 1.0f))
+            return NO_SLOT;
+
+        uint32_t slot = data.mFree.back();
+        data.mFree.pop_back();
+        data.mOrder[slot] = ++mTakes;
+        mLive += data.mParticles;
+        return slot;
+    }
+
+    uint32_t EffectBudget::Oldest(size_t kind) const
+    {
+        auto& order = mKinds[kind].mOrder;
+        uint32_t oldest = NO_SLOT;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            if (order[i] != 0 && (oldest == NO_SLOT || order[i] < order[oldest]))
+                oldest = static_cast<uint32_t>(i);
+        }
+        return oldest;
+    }
+
+    void EffectBudget::Touch(size_t kind, uint32_t slot)
+    {
+        mKinds[kind].mOrder[slot] = ++mTakes;
+    }
+
+    void EffectBudget::Release(size_t kind, uint32_t slot)
+    {
+        auto& data = mKinds[kind];
+        if (data.mOrder[slot] == 0)
+            return;
+
+        data.mOrder[slot] = 0;
+        data.mFree.push_back(slot);
+        mLive -= data.mParticles;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Instances of the particle effects within the budget of the live particles
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Memory.h"
+
+namespace sim
+{
+    // Count of the particles of one instance of the effect
+    struct EffectCost
+    {
+        std::string mName;
+        int mParticles;
+    };
+
+    // Reading the count of the particles of each effect of the file of the effects.
+    // The count of the effect is the sum of numOfParticles of its particle systems.
+    // Effects without a name or with a wrong count are added to errors.
+    bool ParseEffectCosts(const std::string& xml, std::vector<EffectCost>& costs, std::vector<std::string>& errors);
+
+    // Count of the particles of the effect by its name or -1
+    int FindEffectCost(const std::vector<EffectCost>& costs, const std::string& name);
+
+    // Slots of the instances of the effects of several kinds.
+    // A kind has as many slots as its instances fit into the budget, the slots are created at once,
+    // so playing the effects doesn't allocate memory. The particles of the busy slots are never over the budget.
+    class EffectBudget
+    {
+    public:
+        // Index meaning that there is no slot
+        static const uint32_t NO_SLOT = static_cast<uint32_t>(-1);
+
+        EffectBudget();
+
+        // Removing all kinds. The budget is the maximum count of the live particles.
+        void Init(int budget);
+
+        // Adding a kind with the count of the particles of one instance. Returns the index of the kind.
+        size_t AddKind(int particles);
+
+        // Whether the particles fit into the share of the budget together with the live ones
+        bool Fits(int particles, float share) const;
+
+        // Free slot of the kind if its particles fit into the budget or NO_SLOT
+        uint32_t Acquire(size_t kind);
+
+        // Busy slot of the kind taken before all others or NO_SLOT if all slots are free.
+        // Its effect can be restarted at a new place instead of a new instance.
+        uint32_t Oldest(size_t kind) const;
+
+        // Marking the busy slot as the newest one of the kind
+        void Touch(size_t kind, uint32_t slot);
+
+        // Returning the slot of the ended effect to the free ones
+        void Release(size_t kind, uint32_t slot);
+
+        bool IsBusy(size_t kind, uint32_t slot) const { return mKinds[kind].mOrder[slot] != 0; }
+
+        size_t Slots(size_t kind) const { return mKinds[kind].mOrder.size(); }
+
+        // Count of the particles of one instance of the kind
+        int Particles(size_t kind) const { return mKinds[kind].mParticles; }
+
+        size_t KindCount() const { return mKinds.size(); }
+
+        int LiveParticles() const { return mLive; }
+
+        int Budget() const { return mBudget; }
+    private:
+        struct Kind
+        {
+            int mParticles;
+            // Number of the taking of each slot, 0 for the free slots
+            TrackedVector<uint64_t, MemTag::EFFECTS> mOrder;
+            // Indices of the free slots
+            TrackedVector<uint32_t, MemTag::EFFECTS> mFree;
+        };
+
+        TrackedVector<Kind, MemTag::EFFECTS> mKinds;
+        int mBudget;
+        int mLive;
+        // Number of the last taking of a slot
+        uint64_t mTakes;
+    };
+}
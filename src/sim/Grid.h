@@ -0,0 +1,227 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Uniform grid for searching the neighbouring objects
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Memory.h"
+#include "SimTypes.h"
+
+namespace sim
+{
+    // Uniform grid over the bounding rectangle of the objects.
+    // The objects are sorted by cells, so the neighbours of an object are found in the adjacent cells only.
+    class UniformGrid
+    {
+    public:
+        UniformGrid() :
+            mOrigin{ 0.0f, 0.0f },
+            mCellSize(1.0f),
+            mInvCellSize(1.0f),
+            mColumns(0),
+            mRows(0),
+            mCellStart(1, 0)
+        {
+        }
+
+        // Distribution of count objects by cells. The point function returns the position of the object by its index.
+        // The cell size must be not less than the maximum interaction distance.
+        template <class PointFunc>
+        void Build(size_t count, float cell_size, PointFunc point);
+
+        // Reserving the memory for count objects, so the grid of up to them usually doesn't allocate
+        void Reserve(size_t count)
+        {
+            mIndices.reserve(count);
+            mObjectCell.reserve(count);
+            mCellStart.reserve(count * MAX_CELLS_PER_OBJECT + 1);
+            mCursor.reserve(count * MAX_CELLS_PER_OBJECT);
+        }
+
+        // Call of func(i, j) once for every unordered pair of objects from the same or adjacent cells
+        template <class PairFunc>
+        void ForEachPair(PairFunc func) const;
+
+        // Call of func(i) for every object from the cells overlapped by the square around the point
+        template <class ObjectFunc>
+        void ForEachNear(const Vec2& point, float radius, ObjectFunc func) const;
+
+        // Call of func(j) for every object from the cell of the object and the adjacent cells, the object included
+        template <class ObjectFunc>
+        void ForEachAround(size_t object, ObjectFunc func) const;
+
+        // Index of the object at the position in the order of the cells.
+        // Neighbouring positions contain objects close to each other.
+        size_t SortedObject(size_t position) const { return mIndices[position]; }
+
+        size_t Columns() const { return mColumns; }
+        size_t Rows() const { return mRows; }
+    private:
+        // Maximum count of cells per object. Limits the memory of sparse grids.
+        static const size_t MAX_CELLS_PER_OBJECT = 4;
+
+        size_t CellCoord(float value, float origin, size_t limit) const;
+
+        // Origin of the grid and size of one cell
+        Vec2 mOrigin;
+        float mCellSize;
+        float mInvCellSize;
+
+        size_t mColumns;
+        size_t mRows;
+
+        // Start of each cell in the mIndices. Cell c contains mIndices[mCellStart[c]] .. mIndices[mCellStart[c + 1]]
+        TrackedVector<size_t, MemTag::GRID> mCellStart;
+        // Indices of the objects sorted by cells
+        TrackedVector<size_t, MemTag::GRID> mIndices;
+        // Cell of each object
+        TrackedVector<size_t, MemTag::GRID> mObjectCell;
+        // Current filling position of each cell
+        TrackedVector<size_t, MemTag::GRID> mCursor;
+    };
+
+    inline size_t UniformGrid::CellCoord(float value, float origin, size_t limit) const
+    {
+        float coord = (value - origin) * mInvCellSize;
+        if (!(coord > 0.0f))
+            return 0;
+
+        return std::min(static_cast<size_t>(coord), limit - 1);
+    }
+
+    template <class PointFunc>
+    void UniformGrid::Build(size_t count, float cell_size, PointFunc point)
+    {
+        mIndices.resize(count);
+        mObjectCell.resize(count);
+        if (count == 0)
+        {
+            mColumns = mRows = 0;
+            mCellStart.assign(1, 0);
+            return;
+        }
+
+        // Bounding rectangle of all objects
+        Vec2 first = point(0);
+        Bounds box{ first.x, first.x, first.y, first.y };
+        for (size_t i = 1; i < count; i++)
+        {
+            Vec2 p = point(i);
+            box.mMinX = std::min(box.mMinX, p.x);
+            box.mMaxX = std::max(box.mMaxX, p.x);
+            box.mMinY = std::min(box.mMinY, p.y);
+            box.mMaxY = std::max(box.mMaxY, p.y);
+        }
+
+        // If the objects are scattered too widely, the cells are enlarged
+        float width = box.mMaxX - box.mMinX;
+        float height = box.mMaxY - box.mMinY;
+        mCellSize = std::max(cell_size, 1.0f);
+        float max_cells = static_cast<float>(count * MAX_CELLS_PER_OBJECT);
+        if ((width / mCellSize + 1.0f) * (height / mCellSize + 1.0f) > max_cells)
+            mCellSize = std::max(mCellSize, std::sqrt(width * height / max_cells) + 1.0f);
+
+        mInvCellSize = 1.0f / mCellSize;
+        mOrigin = Vec2{ box.mMinX, box.mMinY };
+        mColumns = static_cast<size_t>(width * mInvCellSize) + 1;
+        mRows = static_cast<size_t>(height * mInvCellSize) + 1;
+
+        // Counting sort of the objects by cells
+        mCellStart.assign(mColumns * mRows + 1, 0);
+        for (size_t i = 0; i < count; i++)
+        {
+            Vec2 p = point(i);
+            size_t cell = CellCoord(p.y, mOrigin.y, mRows) * mColumns + CellCoord(p.x, mOrigin.x, mColumns);
+            mObjectCell[i] = cell;
+            ++mCellStart[cell + 1];
+        }
+
+        for (size_t c = 1; c < mCellStart.size(); c++)
+            mCellStart[c] += mCellStart[c - 1];
+
+        mCursor.assign(mCellStart.begin(), mCellStart.end() - 1);
+        for (size_t i = 0; i < count; i++)
+            mIndices[mCursor[mObjectCell[i]]++] = i;
+    }
+
+    template <class PairFunc>
+    void UniformGrid::ForEachPair(PairFunc func) const
+    {
+        // Every cell is checked against itself and the four neighbours ahead of it,
+        // so each pair of adjacent cells is visited once
+        const int offsets[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+
+        for (size_t row = 0; row < mRows; row++)
+            for (size_t col = 0; col < mColumns; col++)
+            {
+                size_t cell = row * mColumns + col;
+                size_t begin = mCellStart[cell];
+                size_t end = mCellStart[cell + 1];
+                if (begin == end)
+                    continue;
+
+                for (size_t a = begin; a < end; a++)
+                    for (size_t b = a + 1; b < end; b++)
+                        func(mIndices[a], mIndices[b]);
+
+                for (auto& offset : offsets)
+                {
+                    long n_col = static_cast<long>(col) + offset[0];
+                    long n_row = static_cast<long>(row) + offset[1];
+                    if (n_col < 0 || n_col >= static_cast<long>(mColumns) || n_row >= static_cast<long>(mRows))
+                        continue;
+
+                    size_t n_cell = static_cast<size_t>(n_row) * mColumns + static_cast<size_t>(n_col);
+                    for (size_t a = begin; a < end; a++)
+                        for (size_t b = mCellStart[n_cell]; b < mCellStart[n_cell + 1]; b++)
+                            func(mIndices[a], mIndices[b]);
+                }
+            }
+    }
+
+    template <class ObjectFunc>
+    void UniformGrid::ForEachAround(size_t object, ObjectFunc func) const
+    {
+        size_t cell = mObjectCell[object];
+        size_t row = cell / mColumns;
+        size_t col = cell % mColumns;
+        size_t min_row = row > 0 ? row - 1 : 0;
+        size_t max_row = std::min(row + 1, mRows - 1);
+        size_t min_col = col > 0 ? col - 1 : 0;
+        size_t max_col = std::min(col + 1, mColumns - 1);
+
+        for (size_t r = min_row; r <= max_row; r++)
+            for (size_t c = min_col; c <= max_col; c++)
+            {
+                size_t n_cell = r * mColumns + c;
+                for (size_t a = mCellStart[n_cell]; a < mCellStart[n_cell + 1]; a++)
+                    func(mIndices[a]);
+            }
+    }
+
+    template <class ObjectFunc>
+    void UniformGrid::ForEachNear(const Vec2& point, float radius, ObjectFunc func) const
+    {
+        if (mColumns == 0)
+            return;
+
+        size_t min_col = CellCoord(point.x - radius, mOrigin.x, mColumns);
+        size_t max_col = CellCoord(point.x + radius, mOrigin.x, mColumns);
+        size_t min_row = CellCoord(point.y - radius, mOrigin.y, mRows);
+        size_t max_row = CellCoord(point.y + radius, mOrigin.y, mRows);
+
+        for (size_t row = min_row; row <= max_row; row++)
+            for (size_t col = min_col; col <= max_col; col++)
+            {
+                size_t cell = row * mColumns + col;
+                for (size_t a = mCellStart[cell]; a < mCellStart[cell + 1]; a++)
+                    func(mIndices[a]);
+            }
+    }
+}
@@ -0,0 +1,233 @@
+/**
+ * \file
+ * \brief Implementation of the queue of the assets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <chrono>
+
+#include "LoadQueue.h"
+#include "Profiler.h"
+
+namespace sim
+{
+    LoadQueue::LoadQueue(size_t thread_count) :
+        mNext(0),
+        mStop(false),
+        mErrors(0)
+    {
+        if (thread_count == 0)
+            thread_count = 1;
+
+        for (size_t i = 0; i < thread_count; i++)
+            mThreads.emplace_back(&LoadQueue::Run, this);
+    }
+
+    LoadQueue::~LoadQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWorkCondition.notify_all();
+        for (auto& thread : mThreads)
+            thread.join();
+    }
+
+    void LoadQueue::Add(int group, const std::string& name, WorkFunc work, FinishFunc finish)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mAssets.push_back(Asset{ group, name, std::move(work), std::move(finish), State::QUEUED, false });
+        }
+        mWorkCondition.notify_one();
+    }
+
+    bool LoadQueue::Poll(double budget)
+    {
+        PROFILE_ZONE("LoadPoll");
+        auto start = std::chrono::steady_clock::now();
+        while (true)
+        {
+            size_t index = 0;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mLoaded.empty())
+                    break;
+                index = mLoaded.front();
+                mLoaded.pop_front();
+            }
+
+            FinishAsset(index);
+
+            // At least one asset is finished, so the loading goes on even with a small budget
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budget)
+                break;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto& asset : mAssets)
+        {
+            if (asset.mState != State::FINISHED)
+                return false;
+        }
+        return true;
+    }
+
+    bool LoadQueue::Require(const std::string& name)
+    {
+        size_t index = 0;
+        WorkFunc work;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (index < mAssets.size() && mAssets[index].mName != name)
+                index++;
+            if (index == mAssets.size())
+                return false;
+
+            Asset& asset = mAssets[index];
+            if (asset.mState == State::FINISHED)
+                return true;
+
+            if (asset.mState == State::QUEUED)
+            {
+                // No worker has taken the asset, so it is loaded here without waiting for the queue
+                asset.mState = State::LOADING;
+                work = std::move(asset.mWork);
+            }
+            else
+            {
+                mLoadedCondition.wait(lock, [&]() { return mAssets[index].mState != State::LOADING; });
+                if (mAssets[index].mState == State::FINISHED)
+                    return true;
+            }
+        }
+
+        if (work)
+            Load(index, std::move(work));
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (auto it = mLoaded.begin(); it != mLoaded.end(); ++it)
+            {
+                if (*it == index)
+                {
+                    mLoaded.erase(it);
+                    break;
+                }
+            }
+        }
+
+        FinishAsset(index);
+        return true;
+    }
+
+    bool LoadQueue::GroupDone(int group) const
+    {
+        size_t done = 0;
+        size_t total = 0;
+        GroupCounts(group, done, total);
+        return done == total;
+    }
+
+    size_t LoadQueue::Errors() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mErrors;
+    }
+
+    void LoadQueue::Run()
+    {
+        while (true)
+        {
+            size_t index = 0;
+            WorkFunc work;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWorkCondition.wait(lock, [this]()
+                {
+                    // The assets taken by Require are skipped
+                    while (mNext < mAssets.size() && mAssets[mNext].mState != State::QUEUED)
+                        mNext++;
+                    return mStop || mNext < mAssets.size();
+                });
+                if (mStop)
+                    return;
+
+                index = mNext++;
+                mAssets[index].mState = State::LOADING;
+                work = std::move(mAssets[index].mWork);
+            }
+
+            Load(index, std::move(work));
+        }
+    }
+
+    void LoadQueue::Load(size_t index, WorkFunc work)
+    {
+        bool ok = false;
+        {
+            PROFILE_ZONE("LoadAsset");
+            ok = work();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            Asset& asset = mAssets[index];
+            asset.mOk = ok;
+            asset.mState = State::LOADED;
+            if (!ok)
+                mErrors++;
+            mLoaded.push_back(index);
+        }
+        mLoadedCondition.notify_all();
+    }
+
+    void LoadQueue::FinishAsset(size_t index)
+    {
+        FinishFunc finish;
+        int group = 0;
+        bool ok = false;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            Asset& asset = mAssets[index];
+            finish = std::move(asset.mFinish);
+            group = asset.mGroup;
+            ok = asset.mOk;
+            name = asset.mName;
+        }
+
+        if (finish)
+            finish(ok);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mAssets[index].mState = State::FINISHED;
+        }
+
+        if (mProgress)
+        {
+            size_t done = 0;
+            size_t total = 0;
+            GroupCounts(group, done, total);
+            mProgress(group, done, total, name);
+        }
+    }
+
+    void LoadQueue::GroupCounts(int group, size_t& done, size_t& total) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        done = 0;
+        total = 0;
+        for (auto& asset : mAssets)
+        {
+            if (asset.mGroup != group)
+                continue;
+            total++;
+            if (asset.mState == State::FINISHED)
+                done++;
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Loading of the assets on the worker threads with the progress
+ * \author Maksimovskiy A.S.
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim
+{
+    // Queue of the assets. The slow part of an asset (reading and decoding) runs on the worker threads,
+    // the part using the engine runs on the main thread in the order the workers finish the assets.
+    // The assets are grouped, the workers take the assets in the order they are added.
+    class LoadQueue
+    {
+    public:
+        // Part of the worker thread. Returns false on error.
+        using WorkFunc = std::function<bool()>;
+        // Part of the main thread, gets the result of the worker part
+        using FinishFunc = std::function<void(bool ok)>;
+        // Progress of the group: finished and total count of its assets and the name of the last finished one
+        using ProgressFunc = std::function<void(int group, size_t done, size_t total, const std::string& name)>;
+
+        explicit LoadQueue(size_t thread_count);
+        ~LoadQueue();
+
+        LoadQueue(const LoadQueue&) = delete;
+        LoadQueue& operator=(const LoadQueue&) = delete;
+
+        // Adding an asset of the group. Its worker part starts as soon as a worker is free.
+        void Add(int group, const std::string& name, WorkFunc work, FinishFunc finish);
+
+        // Function called on the main thread after each finished asset
+        void SetProgress(ProgressFunc progress) { mProgress = std::move(progress); }
+
+        // Finishing the assets done by the workers during at most budget seconds.
+        // Returns true if all added assets are finished.
+        bool Poll(double budget);
+
+        // Finishing the asset at once if it isn't finished yet. The calling thread does its worker part
+        // if no worker has taken it, otherwise it waits for the worker. Returns false if there is no such asset.
+        bool Require(const std::string& name);
+
+        // Whether all assets of the group are finished
+        bool GroupDone(int group) const;
+
+        // Count of the assets whose worker part has failed
+        size_t Errors() const;
+
+        size_t ThreadCount() const { return mThreads.size(); }
+    private:
+        enum class State : uint8_t
+        {
+            QUEUED,
+            LOADING,
+            LOADED,
+            FINISHED
+        };
+
+        struct Asset
+        {
+            int mGroup;
+            std::string mName;
+            WorkFunc mWork;
+            FinishFunc mFinish;
+            State mState;
+            bool mOk;
+        };
+
+        // Loop of a worker thread
+        void Run();
+
+        // Running the worker part of the asset taken from the queue
+        void Load(size_t index, WorkFunc work);
+
+        // Running the main thread part of the loaded asset
+        void FinishAsset(size_t index);
+
+        // Counts of the finished and all assets of the group
+        void GroupCounts(int group, size_t& done, size_t& total) const;
+
+        // The assets are changed only under the mutex, the worker parts run without it
+        mutable std::mutex mMutex;
+        std::condition_variable mWorkCondition;
+        std::condition_variable mLoadedCondition;
+        // Assets in the order of their adding
+        std::deque<Asset> mAssets;
+        // Indices of the loaded assets in the order of their loading
+        std::deque<size_t> mLoaded;
+        // First asset which may be still queued
+        size_t mNext;
+        bool mStop;
+
+        size_t mErrors;
+        ProgressFunc mProgress;
+
+        std::vector<std::thread> mThreads;
+    };
+}
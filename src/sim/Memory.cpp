@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \brief Implementation of the accounting of the memory
+ * \author Maksimovskiy A.S.
+ */
+
+#include <fstream>
+
+#include "Memory.h"
+
+namespace sim
+{
+    const char* MemTagName(MemTag tag)
+    {
+        switch (tag)
+        {
+        case MemTag::TARGETS:
+            return "Targets";
+        case MemTag::BULLETS:
+            return "Bullets";
+        case MemTag::WAVES:
+            return "Waves";
+        case MemTag::GRID:
+            return "Grid";
+        case MemTag::SNAPSHOT:
+            return "Snapshot";
+        case MemTag::SPRITES:
+            return "Sprites";
+        case MemTag::EFFECTS:
+            return "Effects";
+        case MemTag::AUDIO:
+            return "Audio";
+        case MemTag::ATLAS:
+            return "Atlas";
+        default:
+            return "Unknown";
+        }
+    }
+
+    MemoryTracker& MemoryTracker::Instance()
+    {
+        static MemoryTracker tracker;
+        return tracker;
+    }
+
+    MemoryTracker::MemoryTracker() :
+        mMarkAllocs(),
+        mFrameAllocs(),
+        mMaxFrameAllocs(),
+        mFrames(0),
+        mAllocFrames(0)
+    {
+        for (auto& counters : mCounters)
+        {
+            counters.mLive.store(0);
+            counters.mPeak.store(0);
+            counters.mAllocs.store(0);
+            counters.mFrees.store(0);
+        }
+    }
+
+    void MemoryTracker::Allocated(MemTag tag, size_t bytes)
+    {
+        auto& counters = mCounters[static_cast<size_t>(tag)];
+        counters.mAllocs.fetch_add(1, std::memory_order_relaxed);
+        size_t live = counters.mLive.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+        size_t peak = counters.mPeak.load(std::memory_order_relaxed);
+        while (live > peak && !counters.mPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void MemoryTracker::Freed(MemTag tag, size_t bytes)
+    {
+        auto& counters = mCounters[static_cast<size_t>(tag)];
+        counters.mFrees.fetch_add(1, std::memory_order_relaxed);
+        counters.mLive.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::FrameMark()
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < MEM_TAG_COUNT; i++)
+        {
+            uint64_t allocs = mCounters[i].mAllocs.load(std::memory_order_relaxed);
+            mFrameAllocs[i] = allocs - mMarkAllocs[i];
+            mMarkAllocs[i] = allocs;
+            if (mFrameAllocs[i] > mMaxFrameAllocs[i])
+                mMaxFrameAllocs[i] = mFrameAllocs[i];
+            total += mFrameAllocs[i];
+        }
+
+        mFrames++;
+        if (total > 0)
+            mAllocFrames++;
+    }
+
+    MemoryStats MemoryTracker::Stats(MemTag tag) const
+    {
+        size_t i = static_cast<size_t>(tag);
+        auto& counters = mCounters[i];
+        MemoryStats stats;
+        stats.mLive = counters.mLive.load(std::memory_order_relaxed);
+        stats.mPeak = counters.mPeak.load(std::memory_order_relaxed);
+        stats.mAllocs = counters.mAllocs.load(std::memory_order_relaxed);
+        stats.mFrees = counters.mFrees.load(std::memory_order_relaxed);
+        stats.mFrameAllocs = mFrameAllocs[i];
+        stats.mMaxFrameAllocs = mMaxFrameAllocs[i];
+        return stats;
+    }
+
+    uint64_t MemoryTracker::FrameAllocs() const
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < MEM_TAG_COUNT; i++)
+            total += mFrameAllocs[i];
+        return total;
+    }
+
+    bool MemoryTracker::WriteReport(const std::string& path) const
+    {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+
+        file << "tag,live_bytes,peak_bytes,allocs,frees,frame_allocs,max_frame_allocs\n";
+        for (size_t i = 0; i < MEM_TAG_COUNT; i++)
+        {
+            MemTag tag = static_cast<MemTag>(i);
+            MemoryStats stats = Stats(tag);
+            file << MemTagName(tag) << "," << stats.mLive << "," << stats.mPeak << "," << stats.mAllocs << ","
+                 << stats.mFrees << "," << stats.mFrameAllocs << "," << stats.mMaxFrameAllocs << "\n";
+        }
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Accounting of the memory of the game subsystems
+ * \author Maksimovskiy A.S.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace sim
+{
+    // Subsystem owning the memory
+    enum class MemTag : uint8_t
+    {
+        // Arrays of the targets and the buffers of their spawning
+        TARGETS,
+        // Arrays of the bullets in flight and the bullets of the gun with their effects
+        BULLETS,
+        // Counts of the targets of the waves
+        WAVES,
+        // Cells of the grid of the neighbouring targets
+        GRID,
+        // Copy of the state for drawing
+        SNAPSHOT,
+        // Vertices and groups of the sprites
+        SPRITES,
+        // Slots of the particle effects
+        EFFECTS,
+        // Voices of the sounds
+        AUDIO,
+        // Parts of the atlas texture by the names of the images
+        ATLAS,
+        COUNT
+    };
+
+    const size_t MEM_TAG_COUNT = static_cast<size_t>(MemTag::COUNT);
+
+    const char* MemTagName(MemTag tag);
+
+    // Memory of one subsystem
+    struct MemoryStats
+    {
+        // Bytes allocated now and the maximum of them
+        size_t mLive;
+        size_t mPeak;
+        // Count of the allocations and releases from the start
+        uint64_t mAllocs;
+        uint64_t mFrees;
+        // Allocations during the last frame and the maximum of them
+        uint64_t mFrameAllocs;
+        uint64_t mMaxFrameAllocs;
+    };
+
+    // Counters of the memory allocated by the containers of the subsystems.
+    // The counters are atomic, so the containers of all threads are counted without locks.
+    class MemoryTracker
+    {
+    public:
+        static MemoryTracker& Instance();
+
+        MemoryTracker(const MemoryTracker&) = delete;
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+        void Allocated(MemTag tag, size_t bytes);
+        void Freed(MemTag tag, size_t bytes);
+
+        // End of the frame of the main thread. The allocations since the previous mark belong to the frame.
+        void FrameMark();
+
+        MemoryStats Stats(MemTag tag) const;
+
+        // Allocations of all subsystems during the last frame
+        uint64_t FrameAllocs() const;
+
+        // Count of the marked frames and of the frames with allocations
+        uint64_t Frames() const { return mFrames; }
+        uint64_t AllocFrames() const { return mAllocFrames; }
+
+        // Writing the memory of all subsystems to the file as CSV. Returns false on error.
+        bool WriteReport(const std::string& path) const;
+    private:
+        struct Counters
+        {
+            std::atomic<size_t> mLive;
+            std::atomic<size_t> mPeak;
+            std::atomic<uint64_t> mAllocs;
+            std::atomic<uint64_t> mFrees;
+        };
+
+        MemoryTracker();
+
+        Counters mCounters[MEM_TAG_COUNT];
+
+        // Allocations of the subsystems at the last mark and during the last frame.
+        // They are changed by the main thread only.
+        uint64_t mMarkAllocs[MEM_TAG_COUNT];
+        uint64_t mFrameAllocs[MEM_TAG_COUNT];
+        uint64_t mMaxFrameAllocs[MEM_TAG_COUNT];
+        uint64_t mFrames;
+        uint64_t mAllocFrames;
+    };
+
+    // Allocator of the containers counting their memory for the subsystem
+    template <class T, MemTag TAG>
+    class TrackedAllocator
+    {
+    public:
+        using value_type = T;
+
+        template <class U>
+        struct rebind
+        {
+            using other = TrackedAllocator<U, TAG>;
+        };
+
+        TrackedAllocator() = default;
+
+        template <class U>
+        TrackedAllocator(const TrackedAllocator<U, TAG>&)
+        {
+        }
+
+        T* allocate(size_t count)
+        {
+            T* data = static_cast<T*>(::operator new(count * sizeof(T)));
+            MemoryTracker::Instance().Allocated(TAG, count * sizeof(T));
+            return data;
+        }
+
+        void deallocate(T* data, size_t count)
+        {
+            MemoryTracker::Instance().Freed(TAG, count * sizeof(T));
+            ::operator delete(data);
+        }
+    };
+
+    template <class T, class U, MemTag TAG>
+    bool operator==(const TrackedAllocator<T, TAG>&, const TrackedAllocator<U, TAG>&)
+    {
+        return true;
+    }
+
+    template <class T, class U, MemTag TAG>
+    bool operator!=(const TrackedAllocator<T, TAG>&, const TrackedAllocator<U, TAG>&)
+    {
+        return false;
+    }
+
+    // Containers with the memory of the subsystem
+    template <class T, MemTag TAG>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, TAG>>;
+
+    template <class K, class V, MemTag TAG>
+    using TrackedMap = std::map<K, V, std::less<K>, TrackedAllocator<std::pair<const K, V>, TAG>>;
+}
@@ -0,0 +1,188 @@
+/**
+ * \file
+ * \brief Implementation of the collection of the zones
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include "Profiler.h"
+
+namespace sim
+{
+    namespace
+    {
+        uint64_t SteadyNow()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+    }
+
+    const size_t Profiler::EVENTS_PER_THREAD;
+    const size_t Profiler::FRAME_HISTORY;
+
+    Profiler& Profiler::Instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    Profiler::Profiler() :
+        mEnabled(false),
+        mOrigin(SteadyNow()),
+        mFrameStart(0),
+        mFrameNext(0)
+    {
+        mFrameTimes.reserve(FRAME_HISTORY);
+    }
+
+    Profiler::BufferHolder::~BufferHolder()
+    {
+        if (!mBuffer)
+            return;
+
+        std::lock_guard<std::mutex> lock(Profiler::Instance().mBuffersMutex);
+        mBuffer->mFree = true;
+    }
+
+    uint64_t Profiler::Now() const
+    {
+        return SteadyNow() - mOrigin;
+    }
+
+    Profiler::ThreadBuffer& Profiler::Buffer()
+    {
+        static thread_local BufferHolder holder;
+        if (holder.mBuffer)
+            return *holder.mBuffer;
+
+        // The buffers of the finished threads are reused, so a new pool of threads doesn't add memory
+        std::lock_guard<std::mutex> lock(mBuffersMutex);
+        for (auto& buffer : mBuffers)
+        {
+            if (buffer->mFree)
+            {
+                buffer->mFree = false;
+                holder.mBuffer = buffer.get();
+                return *holder.mBuffer;
+            }
+        }
+
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer);
+        buffer->mEvents.resize(EVENTS_PER_THREAD);
+        buffer->mNext = 0;
+        buffer->mCount = 0;
+        buffer->mThread = static_cast<uint32_t>(mBuffers.size());
+        buffer->mFree = false;
+        holder.mBuffer = buffer.get();
+        mBuffers.push_back(std::move(buffer));
+        return *holder.mBuffer;
+    }
+
+    void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+    {
+        ThreadBuffer& buffer = Buffer();
+        std::lock_guard<std::mutex> lock(buffer.mMutex);
+        buffer.mEvents[buffer.mNext] = ProfileEvent{ name, start, end };
+        buffer.mNext = (buffer.mNext + 1) % EVENTS_PER_THREAD;
+        buffer.mCount = std::min(buffer.mCount + 1, EVENTS_PER_THREAD);
+    }
+
+    void Profiler::FrameMark()
+    {
+        uint64_t now = Now();
+        uint64_t start = mFrameStart;
+        mFrameStart = now;
+        // The first frame has no beginning
+        if (start == 0)
+            return;
+
+        float frame_ms = static_cast<float>((now - start) * 1e-6);
+        if (mFrameTimes.size() < FRAME_HISTORY)
+            mFrameTimes.push_back(frame_ms);
+        else
+            mFrameTimes[mFrameNext] = frame_ms;
+        mFrameNext = (mFrameNext + 1) % FRAME_HISTORY;
+
+        mLastFrame.clear();
+        if (!IsEnabled())
+            return;
+
+        std::lock_guard<std::mutex> buffers_lock(mBuffersMutex);
+        for (auto& buffer : mBuffers)
+        {
+            std::lock_guard<std::mutex> lock(buffer->mMutex);
+            // The zones of a thread are written in the order of their ends, so the frame is at the end of the ring
+            for (size_t i = 0; i < buffer->mCount; i++)
+            {
+                auto& event = buffer->mEvents[(buffer->mNext + EVENTS_PER_THREAD - 1 - i) % EVENTS_PER_THREAD];
+                if (event.mEnd <= start)
+                    break;
+
+                auto zone = std::find_if(mLastFrame.begin(), mLastFrame.end(), [&event](const ZoneTime& time)
+                {
+                    return std::strcmp(time.mName, event.mName) == 0;
+                });
+                if (zone == mLastFrame.end())
+                    zone = mLastFrame.insert(mLastFrame.end(), ZoneTime{ event.mName, 0.0, 0 });
+
+                zone->mMs += (event.mEnd - event.mStart) * 1e-6;
+                zone->mCount++;
+            }
+        }
+
+        std::sort(mLastFrame.begin(), mLastFrame.end(), [](const ZoneTime& a, const ZoneTime& b)
+        {
+            return a.mMs > b.mMs;
+        });
+    }
+
+    double Profiler::FramePercentile(double share) const
+    {
+        if (mFrameTimes.empty())
+            return 0.0;
+
+        mSorted = mFrameTimes;
+        size_t index = std::min(mSorted.size() - 1, static_cast<size_t>(share * mSorted.size()));
+        std::nth_element(mSorted.begin(), mSorted.begin() + index, mSorted.end());
+        return mSorted[index];
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& path, double seconds) const
+    {
+        uint64_t now = Now();
+        uint64_t window = static_cast<uint64_t>(seconds * 1e9);
+        uint64_t first = now > window ? now - window : 0;
+
+        std::ofstream file(path);
+        if (!file)
+            return false;
+
+        // Complete events "X": the beginning and the duration in microseconds
+        file << "{\"traceEvents\":[";
+        bool comma = false;
+        std::lock_guard<std::mutex> buffers_lock(mBuffersMutex);
+        for (auto& buffer : mBuffers)
+        {
+            std::lock_guard<std::mutex> lock(buffer->mMutex);
+            for (size_t i = buffer->mCount; i > 0; i--)
+            {
+                auto& event = buffer->mEvents[(buffer->mNext + EVENTS_PER_THREAD - i) % EVENTS_PER_THREAD];
+                if (event.mEnd < first)
+                    continue;
+
+                file << (comma ? ",\n" : "\n") << "{\"name\":\"" << event.mName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                     << buffer->mThread << ",\"ts\":" << event.mStart / 1000 << "." << event.mStart % 1000 / 100
+                     << ",\"dur\":" << (event.mEnd - event.mStart) / 1000 << "."
+                     << (event.mEnd - event.mStart) % 1000 / 100 << "}";
+                comma = true;
+            }
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Time of the named zones of the code on all threads
+ * \author Maksimovskiy A.S.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// The zones are compiled in by default. With WAR_PROFILER=0 PROFILE_ZONE is empty.
+#ifndef WAR_PROFILER
+#define WAR_PROFILER 1
+#endif
+
+namespace sim
+{
+    // One pass through a zone. The times are in nanoseconds from the creation of the profiler.
+    struct ProfileEvent
+    {
+        const char* mName;
+        uint64_t mStart;
+        uint64_t mEnd;
+    };
+
+    // Total time of a zone in one frame
+    struct ZoneTime
+    {
+        const char* mName;
+        double mMs;
+        int mCount;
+    };
+
+    // Collector of the zones of all threads.
+    // Each thread writes its zones into its own ring buffer, so the zones of the last seconds are kept
+    // with a fixed memory. While the profiler is disabled the zones only check the flag.
+    class Profiler
+    {
+    public:
+        // Count of the zones kept for each thread
+        static const size_t EVENTS_PER_THREAD = 1 << 16;
+        // Count of the frames for the percentiles of the frame time
+        static const size_t FRAME_HISTORY = 600;
+
+        static Profiler& Instance();
+
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        void SetEnabled(bool enabled) { mEnabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        // Time in nanoseconds from the creation of the profiler
+        uint64_t Now() const;
+
+        // Adding a pass through the zone on the calling thread. The name must live as long as the profiler.
+        void Record(const char* name, uint64_t start, uint64_t end);
+
+        // End of the frame of the main thread. The zones ended during the frame are summed by their names.
+        void FrameMark();
+
+        // Zones of the last frame from the longest one
+        const std::vector<ZoneTime>& LastFrame() const { return mLastFrame; }
+
+        // Percentile of the time of the last frames in milliseconds, share is from 0 to 1
+        double FramePercentile(double share) const;
+
+        // Writing the zones of all threads ended during the last seconds to the file
+        // in the trace event format of chrome://tracing. Returns false on error.
+        bool WriteChromeTrace(const std::string& path, double seconds) const;
+    private:
+        // Ring buffer of the zones of one thread. The lock is taken by the reader only, so it is almost never busy.
+        struct ThreadBuffer
+        {
+            std::mutex mMutex;
+            std::vector<ProfileEvent> mEvents;
+            // Place of the next zone and the count of the written zones
+            size_t mNext;
+            size_t mCount;
+            // Number of the thread in the trace
+            uint32_t mThread;
+            // The thread has finished and the buffer can be taken by a new one
+            bool mFree;
+        };
+
+        // Owner of the buffer of the thread, returns the buffer on the exit of the thread
+        struct BufferHolder
+        {
+            ThreadBuffer* mBuffer = nullptr;
+            ~BufferHolder();
+        };
+
+        Profiler();
+
+        ThreadBuffer& Buffer();
+
+        std::atomic<bool> mEnabled;
+        uint64_t mOrigin;
+
+        mutable std::mutex mBuffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+
+        // End of the last frame
+        uint64_t mFrameStart;
+        std::vector<ZoneTime> mLastFrame;
+
+        // Times of the last frames in milliseconds
+        std::vector<float> mFrameTimes;
+        size_t mFrameNext;
+        mutable std::vector<float> mSorted;
+    };
+
+    // Pass through a zone from the creation to the end of the scope
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* name) :
+            mName(Profiler::Instance().IsEnabled() ? name : nullptr),
+            mStart(mName ? Profiler::Instance().Now() : 0)
+        {
+        }
+
+        ~ProfileZone()
+        {
+            if (mName)
+                Profiler::Instance().Record(mName, mStart, Profiler::Instance().Now());
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+    private:
+        const char* mName;
+        uint64_t mStart;
+    };
+}
+
+#define WAR_PROFILE_JOIN2(a, b) a##b
+#define WAR_PROFILE_JOIN(a, b) WAR_PROFILE_JOIN2(a, b)
+
+#if WAR_PROFILER
+// Zone of the code from this line to the end of the scope. The name is a string literal.
+#define PROFILE_ZONE(name) ::sim::ProfileZone WAR_PROFILE_JOIN(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
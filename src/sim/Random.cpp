@@ -0,0 +1,115 @@
+/**
+ * \file
+ * \brief Implementation of the random numbers generator
+ * \author Maksimovskiy A.S.
+ */
+
+#include "Random.h"
+
+namespace sim
+{
+    namespace
+    {
+        // SplitMix64 spreads the bits of the seed over the whole state, so close seeds give unrelated sequences
+        uint64_t SplitMix(uint64_t& x)
+        {
+            uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+    }
+
+    Random::Random(uint32_t seed, uint32_t stream)
+    {
+        Seed(seed, stream);
+    }
+
+    void Random::Seed(uint32_t seed, uint32_t stream)
+    {
+        mSeed = seed;
+        uint64_t x = seed;
+        uint64_t first = SplitMix(x);
+        uint64_t second = SplitMix(x);
+        mState[0] = static_cast<uint32_t>(first);
+        mState[1] = static_cast<uint32_t>(first >> 32);
+        mState[2] = static_cast<uint32_t>(second);
+        mState[3] = static_cast<uint32_t>(second >> 32);
+
+        for (uint32_t i = 0; i < stream; i++)
+            Jump();
+    }
+
+    Random Random::Stream(uint32_t stream) const
+    {
+        return Random(mSeed, stream);
+    }
+
+    void Random::Jump()
+    {
+        static const uint32_t JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+        uint32_t state[4] = { 0, 0, 0, 0 };
+        for (uint32_t jump : JUMP)
+        {
+            for (int bit = 0; bit < 32; bit++)
+            {
+                if (jump & (1u << bit))
+                {
+                    for (int i = 0; i < 4; i++)
+                        state[i] ^= mState[i];
+                }
+                Next();
+            }
+        }
+
+        for (int i = 0; i < 4; i++)
+            mState[i] = state[i];
+    }
+
+    int Random::GenIntValue(int min, int max)
+    {
+        // The 32 random bits are scaled to the range by multiplication.
+        // The numbers falling into the incomplete last part of the range are thrown away, so all values are equally likely.
+        uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+        if (range > UINT32_MAX)
+            return static_cast<int>(static_cast<int64_t>(min) + Next());
+
+        uint64_t product = static_cast<uint64_t>(Next()) * range;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < range)
+        {
+            uint32_t threshold = static_cast<uint32_t>((UINT64_C(0x100000000) - range) % range);
+            while (low < threshold)
+            {
+                product = static_cast<uint64_t>(Next()) * range;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>(product >> 32));
+    }
+
+    void Random::FillReal(float* out, size_t count, float min, float max)
+    {
+        for (size_t i = 0; i < count; i++)
+            out[i] = GetRealValue(min, max);
+    }
+
+    void Random::FillPoints(float* x, float* y, size_t count, const Bounds& region)
+    {
+        FillReal(x, count, region.mMinX, region.mMaxX);
+        FillReal(y, count, region.mMinY, region.mMaxY);
+    }
+
+    void Random::FillSigns(float* out, size_t count)
+    {
+        // One number gives the signs of 32 values
+        for (size_t i = 0; i < count; i += 32)
+        {
+            uint32_t bits = Next();
+            size_t end = count - i < 32 ? count - i : 32;
+            for (size_t j = 0; j < end; j++)
+                out[i + j] = (bits >> j) & 1 ? 1.0f : -1.0f;
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Random numbers generator of the simulation
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SimTypes.h"
+
+namespace sim
+{
+    // Generator of random integers and real numbers with an explicit seed.
+    // It is xoshiro128**: four words of state, a few operations per number, the period is 2^128 - 1.
+    // The generator isn't shared between threads: each thread takes its own stream of the same seed.
+    class Random
+    {
+    public:
+        explicit Random(uint32_t seed = 0, uint32_t stream = 0);
+
+        // Restart the sequence from the seed. Streams of one seed don't overlap for 2^64 numbers.
+        void Seed(uint32_t seed, uint32_t stream = 0);
+
+        // Generator of the next stream of the same seed, e.g. for the next thread
+        Random Stream(uint32_t stream) const;
+
+        // Next 32 random bits
+        uint32_t Next()
+        {
+            uint32_t result = RotateLeft(mState[1] * 5, 7) * 9;
+            uint32_t t = mState[1] << 9;
+            mState[2] ^= mState[0];
+            mState[3] ^= mState[1];
+            mState[1] ^= mState[2];
+            mState[0] ^= mState[3];
+            mState[2] ^= t;
+            mState[3] = RotateLeft(mState[3], 11);
+            return result;
+        }
+
+        // Generating integers from min to max
+        int GenIntValue(int min, int max);
+
+        // Generating real numbers from min to max
+        float GetRealValue(float min, float max)
+        {
+            // The upper 24 bits give all floats of [0, 1) with the step 2^-24
+            float unit = static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f);
+            return min + (max - min) * unit;
+        }
+
+        // Filling count real numbers from min to max
+        void FillReal(float* out, size_t count, float min, float max);
+
+        // Filling count points inside the region
+        void FillPoints(float* x, float* y, size_t count, const Bounds& region);
+
+        // Filling count signs: 1 or -1 with equal chances
+        void FillSigns(float* out, size_t count);
+    private:
+        static uint32_t RotateLeft(uint32_t x, int k)
+        {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        // Moving the sequence forward by 2^64 numbers
+        void Jump();
+
+        uint32_t mSeed;
+        uint32_t mState[4];
+    };
+}
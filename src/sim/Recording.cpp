@@ -0,0 +1,389 @@
+/**
+ * \file
+ * \brief Implementation of the recording of the simulation sessions
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Recording.h"
+#include "TargetKernels.h"
+#include "World.h"
+
+namespace sim
+{
+    namespace
+    {
+        // Beginning of every log and the version of its format.
+        // The log keeps only the seed of the random numbers, so the version changes with the generator.
+        const char MAGIC[4] = { 'W', 'R', 'E', 'C' };
+        const uint8_t VERSION = 6;
+
+        // Type of the record of the log
+        enum class Event : uint8_t
+        {
+            INIT,
+            SPAWN,
+            FIRE,
+            STEP,
+            UPDATE,
+            CLEAR_TARGETS,
+            CLEAR_BULLETS,
+            TICK_RATE,
+            WAVES,
+            THREADS,
+            FINISH
+        };
+
+        // Sequential reading of the values of the log
+        class Reader
+        {
+        public:
+            explicit Reader(const std::vector<uint8_t>& data) : mData(data), mPos(0) {}
+
+            template <class T>
+            bool Read(T& value)
+            {
+                if (mData.size() - mPos < sizeof(T))
+                    return false;
+
+                std::memcpy(&value, mData.data() + mPos, sizeof(T));
+                mPos += sizeof(T);
+                return true;
+            }
+
+            bool ReadDesc(TargetDesc& desc)
+            {
+                return Read(desc.mArchetype) && Read(desc.mMovement) && Read(desc.mRadius) && Read(desc.mDeltaX) &&
+                       Read(desc.mDeltaY) && Read(desc.mHP) && Read(desc.mMinSpeed) && Read(desc.mMaxSpeed);
+            }
+
+            bool AtEnd() const { return mPos == mData.size(); }
+        private:
+            const std::vector<uint8_t>& mData;
+            size_t mPos;
+        };
+
+        // FNV-1a hash of the bytes of the array
+        template <class T, class Allocator>
+        void HashArray(uint64_t& hash, const std::vector<T, Allocator>& values)
+        {
+            auto bytes = reinterpret_cast<const uint8_t*>(values.data());
+            for (size_t i = 0; i < values.size() * sizeof(T); i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+
+    uint64_t StateHash(const World& world)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        auto& targets = world.Targets();
+        HashArray(hash, targets.X());
+        HashArray(hash, targets.Y());
+        HashArray(hash, targets.VelocityX());
+        HashArray(hash, targets.VelocityY());
+        HashArray(hash, targets.HP());
+
+        auto& bullets = world.Bullets();
+        HashArray(hash, bullets.Ids());
+        std::vector<float> state;
+        state.reserve(bullets.Size() * N_DIM);
+        for (size_t i = 0; i < bullets.Size(); i++)
+        {
+            Bullet bullet = bullets.Get(i);
+            state.insert(state.end(), std::begin(bullet.mXY), std::end(bullet.mXY));
+        }
+        HashArray(hash, state);
+        return hash;
+    }
+
+    Recorder::Recorder() :
+        mRecording(false)
+    {
+    }
+
+    template <class T>
+    void Recorder::Write(const T& value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        mData.insert(mData.end(), bytes, bytes + sizeof(T));
+    }
+
+    void Recorder::Begin(uint32_t seed)
+    {
+        mData.assign(std::begin(MAGIC), std::end(MAGIC));
+        Write(VERSION);
+        Write(seed);
+        // The vector kernels round differently, so the replay uses the same instruction set
+        Write(static_cast<uint8_t>(DetectSimd()));
+        mRecording = true;
+    }
+
+    void Recorder::Init(const Bounds& bounds)
+    {
+        Write(Event::INIT);
+        Write(bounds);
+    }
+
+    void Recorder::WriteDesc(const TargetDesc& desc)
+    {
+        // The fields are written separately, so the padding of the structure doesn't get into the log
+        Write(desc.mArchetype);
+        Write(desc.mMovement);
+        Write(desc.mRadius);
+        Write(desc.mDeltaX);
+        Write(desc.mDeltaY);
+        Write(desc.mHP);
+        Write(desc.mMinSpeed);
+        Write(desc.mMaxSpeed);
+    }
+
+    void Recorder::Spawn(const TargetDesc& desc, int count, const Bounds& region)
+    {
+        Write(Event::SPAWN);
+        WriteDesc(desc);
+        Write(count);
+        Write(region);
+    }
+
+    void Recorder::Waves(const WavePlan& plan)
+    {
+        // The targets of the waves are spawned by the steps, so only the plan is written
+        Write(Event::WAVES);
+        Write(static_cast<uint32_t>(plan.mGroups.size()));
+        for (auto& group : plan.mGroups)
+        {
+            WriteDesc(group.mDesc);
+            Write(group.mCount);
+        }
+        Write(plan.mRegion);
+        Write(plan.mInterval);
+        Write(plan.mWaveCount);
+        Write(plan.mSpawnBudget);
+        Write(plan.mMaxAlive);
+    }
+
+    void Recorder::Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert)
+    {
+        Write(Event::FIRE);
+        Write(id);
+        Write(desc);
+        Write(point);
+        Write(rotate_angle);
+        Write(static_cast<uint8_t>(invert));
+    }
+
+    void Recorder::Step(float dt)
+    {
+        Write(Event::STEP);
+        Write(dt);
+    }
+
+    void Recorder::Update(float dt)
+    {
+        Write(Event::UPDATE);
+        Write(dt);
+    }
+
+    void Recorder::ClearTargets()
+    {
+        Write(Event::CLEAR_TARGETS);
+    }
+
+    void Recorder::ClearBullets()
+    {
+        Write(Event::CLEAR_BULLETS);
+    }
+
+    void Recorder::TickRate(int tick_rate, int max_steps)
+    {
+        Write(Event::TICK_RATE);
+        Write(tick_rate);
+        Write(max_steps);
+    }
+
+    void Recorder::ThreadCount(size_t count)
+    {
+        Write(Event::THREADS);
+        Write(static_cast<uint32_t>(count));
+    }
+
+    void Recorder::Finish(const World& world)
+    {
+        if (!mRecording)
+            return;
+
+        Write(Event::FINISH);
+        Write(StateHash(world));
+        mRecording = false;
+    }
+
+    bool Recorder::Save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(mData.data()), static_cast<std::streamsize>(mData.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool Replayer::Load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return Load(data);
+    }
+
+    bool Replayer::Load(const std::vector<uint8_t>& data)
+    {
+        Reader reader(data);
+        char magic[4];
+        uint8_t version = 0;
+        if (!reader.Read(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            !reader.Read(version) || version != VERSION ||
+            !reader.Read(mSeed) || !reader.Read(mSimdLevel) || mSimdLevel > static_cast<uint8_t>(SimdLevel::AVX2))
+            return false;
+
+        mData = data;
+        return true;
+    }
+
+    ReplayResult Replayer::Run(World& world) const
+    {
+        ReplayResult result{ false, 0, 0, false, 0, 0 };
+        // The kernels of the levels differ in the rounding, so the session can't be repeated exactly with another one
+        if (!IsSimdSupported(Simd()))
+            return result;
+        world.Targets().SetSimdLevel(Simd());
+
+        // Skipping the header checked on loading
+        Reader reader(mData);
+        char magic[4];
+        uint8_t version;
+        uint32_t seed;
+        uint8_t simd_level;
+        reader.Read(magic);
+        reader.Read(version);
+        reader.Read(seed);
+        reader.Read(simd_level);
+
+        Event event;
+        bool valid = true;
+        while (valid && reader.Read(event))
+        {
+            switch (event)
+            {
+            case Event::INIT:
+            {
+                Bounds bounds;
+                valid = reader.Read(bounds);
+                if (valid)
+                    world.Init(bounds);
+                break;
+            }
+            case Event::SPAWN:
+            {
+                TargetDesc desc;
+                int count;
+                Bounds region;
+                valid = reader.ReadDesc(desc) && reader.Read(count) && reader.Read(region);
+                if (valid)
+                    world.SpawnTargets(desc, count, region);
+                break;
+            }
+            case Event::FIRE:
+            {
+                uint32_t id;
+                BulletDesc desc;
+                Vec2 point;
+                float rotate_angle;
+                uint8_t invert;
+                valid = reader.Read(id) && reader.Read(desc) && reader.Read(point) &&
+                        reader.Read(rotate_angle) && reader.Read(invert);
+                if (valid)
+                    world.Fire(id, desc, point, rotate_angle, invert != 0);
+                break;
+            }
+            case Event::STEP:
+            {
+                float dt;
+                valid = reader.Read(dt);
+                if (valid)
+                {
+                    world.Step(dt);
+                    result.mSteps++;
+                }
+                break;
+            }
+            case Event::UPDATE:
+            {
+                float dt;
+                valid = reader.Read(dt);
+                if (valid)
+                {
+                    result.mSteps += world.Update(dt);
+                    result.mUpdates++;
+                }
+                break;
+            }
+            case Event::CLEAR_TARGETS:
+                world.ClearTargets();
+                break;
+            case Event::CLEAR_BULLETS:
+                world.ClearBullets();
+                break;
+            case Event::TICK_RATE:
+            {
+                int tick_rate;
+                int max_steps;
+                valid = reader.Read(tick_rate) && reader.Read(max_steps);
+                if (valid)
+                    world.SetTickRate(tick_rate, max_steps);
+                break;
+            }
+            case Event::THREADS:
+            {
+                uint32_t count;
+                valid = reader.Read(count);
+                if (valid)
+                    world.SetThreadCount(count);
+                break;
+            }
+            case Event::WAVES:
+            {
+                WavePlan plan;
+                uint32_t size = 0;
+                valid = reader.Read(size);
+                for (uint32_t i = 0; valid && i < size; i++)
+                {
+                    WaveGroup group;
+                    valid = reader.ReadDesc(group.mDesc) && reader.Read(group.mCount);
+                    plan.mGroups.push_back(group);
+                }
+                valid = valid && reader.Read(plan.mRegion) && reader.Read(plan.mInterval) &&
+                        reader.Read(plan.mWaveCount) && reader.Read(plan.mSpawnBudget) && reader.Read(plan.mMaxAlive);
+                if (valid)
+                    world.StartWaves(plan);
+                break;
+            }
+            case Event::FINISH:
+                valid = reader.Read(result.mExpectedHash);
+                result.mHasExpectedHash = valid;
+                break;
+            default:
+                valid = false;
+                break;
+            }
+        }
+
+        result.mComplete = valid && reader.AtEnd();
+        result.mHash = StateHash(world);
+        return result;
+    }
+}
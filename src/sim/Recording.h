@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Recording of the simulation sessions and their replay
+ * \author Maksimovskiy A.S.
+ */
+
+#include <string>
+#include <vector>
+
+#include "Bullets.h"
+#include "Targets.h"
+#include "Waves.h"
+
+namespace sim
+{
+    class World;
+
+    // Hash of the state of all targets and bullets. Equal states have equal hashes.
+    uint64_t StateHash(const World& world);
+
+    // Log of all changes of the world in the order they were applied.
+    // The changes are stored in a compact binary form in memory and saved at once.
+    class Recorder
+    {
+    public:
+        Recorder();
+
+        // Start of the log for the world created with the seed
+        void Begin(uint32_t seed);
+
+        bool IsRecording() const { return mRecording; }
+
+        // Changes of the world, called by the world itself
+        void Init(const Bounds& bounds);
+        void Spawn(const TargetDesc& desc, int count, const Bounds& region);
+        void Waves(const WavePlan& plan);
+        void Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert);
+        void Step(float dt);
+        void Update(float dt);
+        void ClearTargets();
+        void ClearBullets();
+        void TickRate(int tick_rate, int max_steps);
+        void ThreadCount(size_t count);
+
+        // End of the log with the hash of the final state of the world
+        void Finish(const World& world);
+
+        // Saving the log to the file. Returns false on error.
+        bool Save(const std::string& path) const;
+
+        const std::vector<uint8_t>& Data() const { return mData; }
+    private:
+        template <class T>
+        void Write(const T& value);
+
+        void WriteDesc(const TargetDesc& desc);
+
+        std::vector<uint8_t> mData;
+        bool mRecording;
+    };
+
+    // Result of the replay of the log
+    struct ReplayResult
+    {
+        // The log was read to the end without errors
+        bool mComplete;
+
+        // Counts of the updates and of the fixed steps made by them
+        size_t mUpdates;
+        size_t mSteps;
+
+        // Hash of the final state stored in the log and the hash of the replayed state
+        bool mHasExpectedHash;
+        uint64_t mExpectedHash;
+        uint64_t mHash;
+    };
+
+    // Replay of the log without drawing and without waiting for the real time
+    class Replayer
+    {
+    public:
+        // Loading the log from the file. Returns false if the file can't be read or isn't a log.
+        bool Load(const std::string& path);
+
+        // Using the log from memory
+        bool Load(const std::vector<uint8_t>& data);
+
+        // Seed of the world of the recorded session
+        uint32_t Seed() const { return mSeed; }
+
+        // Instruction set of the recorded session
+        SimdLevel Simd() const { return static_cast<SimdLevel>(mSimdLevel); }
+
+        // Applying all changes of the log to the world created with Seed().
+        // The log isn't replayed if the processor can't run the instruction set of the session.
+        ReplayResult Run(World& world) const;
+    private:
+        std::vector<uint8_t> mData;
+        uint32_t mSeed;
+        // Instruction set of the recorded session
+        uint8_t mSimdLevel;
+    };
+}
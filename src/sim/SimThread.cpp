@@ -0,0 +1,124 @@
+/**
+ * \file
+ * \brief Implementation of the simulation thread
+ * \author Maksimovskiy A.S.
+ */
+
+#include "Profiler.h"
+#include "SimThread.h"
+
+namespace sim
+{
+    SimThread::SimThread(World& world) :
+        mWorld(world),
+        mFront(0),
+        mHasBack(false),
+        mBusy(false),
+        mStop(false),
+        mDt(0.0f)
+    {
+        mThread = std::thread(&SimThread::Run, this);
+    }
+
+    SimThread::~SimThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        mThread.join();
+    }
+
+    void SimThread::Post(WorldCommand command)
+    {
+        std::lock_guard<std::mutex> lock(mCommandMutex);
+        mCommands.push_back(std::move(command));
+    }
+
+    uint32_t SimThread::Fire(const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert)
+    {
+        // The identifier is known at once, though the bullet appears only on the next update
+        uint32_t id = mWorld.ReserveBulletId();
+        Post([=](World& world)
+        {
+            world.Fire(id, desc, point, rotate_angle, invert);
+        });
+        return id;
+    }
+
+    void SimThread::Frame(float dt)
+    {
+        // Time of the main thread waiting for the simulation of the previous frame
+        {
+            PROFILE_ZONE("SimWait");
+            WaitIdle();
+        }
+
+        if (mHasBack)
+            mFront = 1 - mFront;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDt = dt;
+            mBusy = true;
+            mHasBack = true;
+        }
+        mCondition.notify_all();
+    }
+
+    void SimThread::Flush()
+    {
+        WaitIdle();
+
+        // The thread is idle, so the world is processed on the calling thread.
+        // The result of the last update isn't needed anymore.
+        ExecuteCommands();
+        mSnapshots[mFront].Capture(mWorld);
+        mHasBack = false;
+    }
+
+    void SimThread::Run()
+    {
+        while (true)
+        {
+            float dt = 0.0f;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this]() { return mBusy || mStop; });
+                if (mStop)
+                    return;
+                dt = mDt;
+            }
+
+            PROFILE_ZONE("SimUpdate");
+            ExecuteCommands();
+            mWorld.Update(dt);
+            mSnapshots[1 - mFront].Capture(mWorld);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mBusy = false;
+            }
+            mCondition.notify_all();
+        }
+    }
+
+    void SimThread::WaitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return !mBusy; });
+    }
+
+    void SimThread::ExecuteCommands()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mCommandMutex);
+            mRunningCommands.swap(mCommands);
+        }
+
+        for (auto& command : mRunningCommands)
+            command(mWorld);
+        mRunningCommands.clear();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Simulation of the battlefield on a separate thread
+ * \author Maksimovskiy A.S.
+ */
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Snapshot.h"
+#include "World.h"
+
+namespace sim
+{
+    // Command changing the world. It is executed on the simulation thread before the next update.
+    using WorldCommand = std::function<void(World& world)>;
+
+    // Thread advancing the world while the main thread draws the previous frame.
+    // The state is exchanged through two snapshots: the front one is drawn, the back one is filled by the thread.
+    // While the thread runs, the world is changed only by the commands.
+    class SimThread
+    {
+    public:
+        explicit SimThread(World& world);
+        ~SimThread();
+
+        SimThread(const SimThread&) = delete;
+        SimThread& operator=(const SimThread&) = delete;
+
+        // Adding a command to the queue
+        void Post(WorldCommand command);
+
+        // Shot of a new bullet on the next update. Returns the bullet identifier.
+        uint32_t Fire(const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert);
+
+        // Waiting for the update of the previous frame, publishing its state
+        // and starting the update of the world for dt seconds
+        void Frame(float dt);
+
+        // Waiting for the running update and executing all commands at once.
+        // The state is published immediately, so the next drawing sees the result of the commands.
+        void Flush();
+
+        // State of the simulation for drawing
+        const Snapshot& Front() const { return mSnapshots[mFront]; }
+    private:
+        void Run();
+
+        // Waiting until the thread doesn't process the world
+        void WaitIdle();
+
+        void ExecuteCommands();
+
+        World& mWorld;
+
+        Snapshot mSnapshots[2];
+        // Index of the snapshot for drawing
+        size_t mFront;
+        // The back snapshot is filled by the last update and isn't published yet
+        bool mHasBack;
+
+        // Commands from the main thread
+        std::vector<WorldCommand> mCommands;
+        std::mutex mCommandMutex;
+        // Commands being executed. Used only by the thread processing the world.
+        std::vector<WorldCommand> mRunningCommands;
+
+        // State of the thread
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mBusy;
+        bool mStop;
+        // Time of the requested update
+        float mDt;
+
+        std::thread mThread;
+    };
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Basic types of the headless simulation
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sim
+{
+    // Pi number
+    const float PI = 3.14159265358979f;
+    // 180 degree angle
+    const float PI_DEGREES = 180.0f;
+
+    // Point or vector on the plane
+    struct Vec2
+    {
+        float x;
+        float y;
+    };
+
+    // Rectangle limiting the movement of the objects
+    struct Bounds
+    {
+        float mMinX;
+        float mMaxX;
+        float mMinY;
+        float mMaxY;
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Constants of the polynomial sine and cosine used by the vector kernels
+ * \author Maksimovskiy A.S.
+ */
+
+namespace sim
+{
+    namespace sincos_poly
+    {
+        // The angle is reduced to [-PI/4, PI/4] by subtracting j * PI/4, where j is even.
+        // PI/4 is split into three parts to keep the precision of the subtraction.
+        const float FOUR_OVER_PI = 1.27323954473516f;
+        const float DP1 = 0.78515625f;
+        const float DP2 = 2.4187564849853515625e-4f;
+        const float DP3 = 3.77489497744594108e-8f;
+
+        // Coefficients of the sine polynomial on [-PI/4, PI/4]
+        const float S1 = -1.9515295891e-4f;
+        const float S2 = 8.3321608736e-3f;
+        const float S3 = -1.6666654611e-1f;
+
+        // Coefficients of the cosine polynomial on [-PI/4, PI/4]
+        const float C1 = 2.443315711809948e-5f;
+        const float C2 = -1.388731625493765e-3f;
+        const float C3 = 4.166664568298827e-2f;
+
+        // Full circle for the timer wrapping
+        const float TWO_PI = 6.28318530717959f;
+    }
+}
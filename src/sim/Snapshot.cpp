@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief Implementation of the copy of the simulation state
+ * \author Maksimovskiy A.S.
+ */
+
+#include "Profiler.h"
+#include "Snapshot.h"
+#include "World.h"
+
+namespace sim
+{
+    Snapshot::Snapshot() :
+        mLastBulletId(0),
+        mWave(0),
+        mWavesDone(true),
+        mAlpha(0.0f)
+    {
+    }
+
+    void Snapshot::Capture(const World& world)
+    {
+        PROFILE_ZONE("Capture");
+        auto& targets = world.Targets();
+        // The arrays follow the memory reserved by the world, so they don't grow with each new maximum
+        Reserve(targets.X().capacity(), world.Bullets().Capacity());
+        mX.assign(targets.X().begin(), targets.X().end());
+        mY.assign(targets.Y().begin(), targets.Y().end());
+        mPrevX.assign(targets.PrevX().begin(), targets.PrevX().end());
+        mPrevY.assign(targets.PrevY().begin(), targets.PrevY().end());
+        mDeltaX.assign(targets.DeltaX().begin(), targets.DeltaX().end());
+        mDeltaY.assign(targets.DeltaY().begin(), targets.DeltaY().end());
+        mArchetype.assign(targets.Archetype().begin(), targets.Archetype().end());
+
+        auto& bullets = world.Bullets();
+        mBullets.resize(bullets.Size());
+        for (size_t i = 0; i < bullets.Size(); i++)
+            mBullets[i] = bullets.Get(i);
+
+        mRetired.assign(world.RetiredBullets().begin(), world.RetiredBullets().end());
+        mLastBulletId = world.LastBulletId();
+        mWave = world.Waves().Wave();
+        mWavesDone = world.Waves().Done();
+        mAlpha = world.Alpha();
+    }
+
+    void Snapshot::Reserve(size_t targets, size_t bullets)
+    {
+        mX.reserve(targets);
+        mY.reserve(targets);
+        mPrevX.reserve(targets);
+        mPrevY.reserve(targets);
+        mDeltaX.reserve(targets);
+        mDeltaY.reserve(targets);
+        mArchetype.reserve(targets);
+        mBullets.reserve(bullets);
+        mRetired.reserve(bullets);
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Copy of the simulation state for drawing
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "Bullets.h"
+#include "Memory.h"
+#include "Targets.h"
+
+namespace sim
+{
+    class World;
+
+    // State of the targets and bullets needed to draw one frame.
+    // It is filled by the simulation thread and read by the drawing one.
+    struct Snapshot
+    {
+        Snapshot();
+
+        // Copying the state of the world. The arrays keep their memory between the frames.
+        void Capture(const World& world);
+
+        // Reserving the memory for count targets and bullets
+        void Reserve(size_t targets, size_t bullets);
+
+        size_t TargetCount() const { return mX.size(); }
+
+        // Target position, its position before the last step, coordinate adjustment and type
+        TrackedVector<float, MemTag::SNAPSHOT> mX;
+        TrackedVector<float, MemTag::SNAPSHOT> mY;
+        TrackedVector<float, MemTag::SNAPSHOT> mPrevX;
+        TrackedVector<float, MemTag::SNAPSHOT> mPrevY;
+        TrackedVector<float, MemTag::SNAPSHOT> mDeltaX;
+        TrackedVector<float, MemTag::SNAPSHOT> mDeltaY;
+        TrackedVector<uint16_t, MemTag::SNAPSHOT> mArchetype;
+
+        // Bullets in flight in the order of the shots
+        TrackedVector<Bullet, MemTag::SNAPSHOT> mBullets;
+
+        // Bullets removed during the last update in the order of the shots
+        TrackedVector<Bullet, MemTag::SNAPSHOT> mRetired;
+
+        // Identifier of the last bullet added to the world.
+        // Bullets with greater identifiers are fired, but not simulated yet.
+        uint32_t mLastBulletId;
+
+        // Count of the started waves and whether all their targets are spawned
+        int mWave;
+        bool mWavesDone;
+
+        // Share of the next step covered by the time of the updates
+        float mAlpha;
+    };
+}
@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \brief Implementation of the building of the sprite vertices
+ * \author Maksimovskiy A.S.
+ */
+
+#include "SpriteBatch.h"
+#include "Trig.h"
+
+namespace sim
+{
+    size_t SpriteBatch::Frame(const void* image, const void* texture, float width, float height, const UvRect& uv)
+    {
+        size_t frame = FindFrame(image);
+        if (frame != NO_FRAME)
+            return frame;
+
+        // There are only a few textures and images, so the searches are linear
+        size_t group = 0;
+        while (group < mGroups.size() && mGroups[group].mTexture != texture)
+            group++;
+        if (group == mGroups.size())
+            mGroups.push_back(SpriteGroup{ texture, {} });
+
+        mFrames.push_back(SpriteFrame{ image, group, width, height, uv });
+        return mFrames.size() - 1;
+    }
+
+    size_t SpriteBatch::FindFrame(const void* image) const
+    {
+        for (size_t i = 0; i < mFrames.size(); i++)
+        {
+            if (mFrames[i].mImage == image)
+                return i;
+        }
+
+        return NO_FRAME;
+    }
+
+    void SpriteBatch::Add(size_t frame, float x, float y)
+    {
+        const SpriteFrame& f = mFrames[frame];
+        const UvRect& uv = f.mUv;
+        auto& vertices = mGroups[f.mGroup].mVertices;
+        vertices.push_back(SpriteVertex{ x, y, uv.mU0, uv.mV0 });
+        vertices.push_back(SpriteVertex{ x + f.mWidth, y, uv.mU1, uv.mV0 });
+        vertices.push_back(SpriteVertex{ x, y + f.mHeight, uv.mU0, uv.mV1 });
+        vertices.push_back(SpriteVertex{ x + f.mWidth, y + f.mHeight, uv.mU1, uv.mV1 });
+    }
+
+    void SpriteBatch::Add(size_t frame, float x, float y, float angle)
+    {
+        const SpriteFrame& f = mFrames[frame];
+        const UvRect& uv = f.mUv;
+        auto& vertices = mGroups[f.mGroup].mVertices;
+        float s, c;
+        SinCosDeg(angle, s, c);
+
+        // Sides of the image turned by the angle counterclockwise
+        float wx = f.mWidth * c;
+        float wy = f.mWidth * s;
+        float hx = -f.mHeight * s;
+        float hy = f.mHeight * c;
+        vertices.push_back(SpriteVertex{ x, y, uv.mU0, uv.mV0 });
+        vertices.push_back(SpriteVertex{ x + wx, y + wy, uv.mU1, uv.mV0 });
+        vertices.push_back(SpriteVertex{ x + hx, y + hy, uv.mU0, uv.mV1 });
+        vertices.push_back(SpriteVertex{ x + wx + hx, y + wy + hy, uv.mU1, uv.mV1 });
+    }
+
+    void SpriteBatch::Clear()
+    {
+        for (auto& group : mGroups)
+            group.mVertices.clear();
+    }
+
+    BatchStats SpriteBatch::Stats() const
+    {
+        BatchStats stats{ 0, 0, 0 };
+        for (auto& group : mGroups)
+        {
+            if (group.mVertices.empty())
+                continue;
+
+            stats.mBatches++;
+            stats.mVertices += group.mVertices.size();
+            stats.mSprites += group.mVertices.size() / 4;
+        }
+        return stats;
+    }
+}
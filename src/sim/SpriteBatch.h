@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Building of the vertices of the sprites grouped by texture
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "Memory.h"
+#include "SimTypes.h"
+
+namespace sim
+{
+    // Corner of a sprite quad: position on the screen and texture coordinates
+    struct SpriteVertex
+    {
+        float x;
+        float y;
+        float u;
+        float v;
+    };
+
+    // Texture coordinates of the image of the sprite
+    struct UvRect
+    {
+        float mU0;
+        float mV0;
+        float mU1;
+        float mV1;
+    };
+
+    // Count of the sprites, draw calls and vertices of a frame
+    struct BatchStats
+    {
+        size_t mSprites;
+        size_t mBatches;
+        size_t mVertices;
+    };
+
+    // Image drawn by the sprites. Several images may be parts of one texture.
+    struct SpriteFrame
+    {
+        // Image of the engine. It isn't used here, only identifies the frame.
+        const void* mImage;
+
+        // Group of the texture containing the image
+        size_t mGroup;
+
+        // Size of the image
+        float mWidth;
+        float mHeight;
+
+        UvRect mUv;
+    };
+
+    // Group of the sprites with the same texture. They are drawn by one call.
+    struct SpriteGroup
+    {
+        // Texture of the engine. It isn't used here, only identifies the group.
+        const void* mTexture;
+
+        // Four corners of each sprite: (0, 0), (width, 0), (0, height), (width, height) of its image
+        TrackedVector<SpriteVertex, MemTag::SPRITES> mVertices;
+    };
+
+    // Collecting the quads of all sprites of a frame into the arrays of their textures.
+    // It doesn't use the engine, so the vertices can be checked without drawing.
+    class SpriteBatch
+    {
+    public:
+        // Index of the frame of the image with the size and texture coordinates inside the texture.
+        // The frame and the group of the texture are added on the first call.
+        size_t Frame(const void* image, const void* texture, float width, float height, const UvRect& uv);
+
+        // Index of the frame of the image already added or NO_FRAME
+        size_t FindFrame(const void* image) const;
+
+        // Sprite with the image corner at the point
+        void Add(size_t frame, float x, float y);
+
+        // Sprite rotated by the angle in degrees around the image corner at the point
+        void Add(size_t frame, float x, float y, float angle);
+
+        // Removing the sprites of all groups. The memory of the arrays is kept for the next frame.
+        void Clear();
+
+        const TrackedVector<SpriteFrame, MemTag::SPRITES>& Frames() const { return mFrames; }
+
+        const TrackedVector<SpriteGroup, MemTag::SPRITES>& Groups() const { return mGroups; }
+
+        // Stats of the collected sprites. Only the groups with sprites need a draw call.
+        BatchStats Stats() const;
+
+        static const size_t NO_FRAME = static_cast<size_t>(-1);
+    private:
+        TrackedVector<SpriteFrame, MemTag::SPRITES> mFrames;
+        TrackedVector<SpriteGroup, MemTag::SPRITES> mGroups;
+    };
+}
@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief Implementation of the scheduler of the simulation steps
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+
+#include "StepClock.h"
+
+namespace sim
+{
+    StepClock::StepClock(int tick_rate, int max_steps) :
+        mStep(1.0f / DEFAULT_TICK_RATE),
+        mMaxSteps(DEFAULT_MAX_STEPS),
+        mAccumulator(0.0f)
+    {
+        SetTickRate(tick_rate);
+        SetMaxSteps(max_steps);
+    }
+
+    void StepClock::SetTickRate(int tick_rate)
+    {
+        mStep = 1.0f / std::max(tick_rate, 1);
+        mAccumulator = std::min(mAccumulator, mStep);
+    }
+
+    void StepClock::SetMaxSteps(int max_steps)
+    {
+        mMaxSteps = std::max(max_steps, 1);
+    }
+
+    int StepClock::Advance(float dt)
+    {
+        mAccumulator += std::max(dt, 0.0f);
+
+        int steps = 0;
+        while (mAccumulator >= mStep && steps < mMaxSteps)
+        {
+            mAccumulator -= mStep;
+            steps++;
+        }
+
+        // The simulation can't catch up, the rest of the time is dropped
+        if (steps == mMaxSteps)
+            mAccumulator = std::min(mAccumulator, mStep);
+
+        return steps;
+    }
+
+    void StepClock::Reset()
+    {
+        mAccumulator = 0.0f;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Scheduler of the fixed steps of the simulation
+ * \author Maksimovskiy A.S.
+ */
+
+namespace sim
+{
+    // Default count of the simulation steps per second
+    const int DEFAULT_TICK_RATE = 60;
+    // Default maximum count of the steps made for one frame
+    const int DEFAULT_MAX_STEPS = 5;
+
+    // Accumulator of real time which is spent by the steps of the same length.
+    // The simulation speed doesn't depend on the frame rate.
+    class StepClock
+    {
+    public:
+        explicit StepClock(int tick_rate = DEFAULT_TICK_RATE, int max_steps = DEFAULT_MAX_STEPS);
+
+        // Setting the count of the steps per second
+        void SetTickRate(int tick_rate);
+
+        // Setting the maximum count of the steps made for one frame.
+        // After a long frame the time which can't be caught up is dropped.
+        void SetMaxSteps(int max_steps);
+
+        // Adding dt seconds of real time. Returns the count of the steps to make.
+        int Advance(float dt);
+
+        // Dropping the accumulated time
+        void Reset();
+
+        // Length of one step in seconds
+        float Step() const { return mStep; }
+
+        // Share of the next step covered by the accumulated time, from 0 to 1.
+        // Used to draw the objects between the last two steps.
+        float Alpha() const { return mAccumulator / mStep; }
+    private:
+        float mStep;
+        int mMaxSteps;
+
+        // Real time not spent by the steps yet
+        float mAccumulator;
+    };
+}
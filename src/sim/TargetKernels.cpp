@@ -0,0 +1,290 @@
+/**
+ * \file
+ * \brief Scalar and SSE2 kernels of the movement of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cmath>
+
+#include "SinCosPoly.h"
+#include "TargetKernels.h"
+#include "Trig.h"
+
+#if SIM_X86
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace sim
+{
+    bool Avx2KernelBuilt();
+
+    void MoveScalarRange(const MoveBatch& batch, size_t first, float dt, const Bounds& bounds)
+    {
+        for (size_t i = first; i < batch.mCount; i++)
+        {
+            float& x = batch.mX[i];
+            float& y = batch.mY[i];
+            float& vx = batch.mVx[i];
+            float& vy = batch.mVy[i];
+
+            if (batch.mNonlinear[i] > 0.0f)
+            {
+                // Nonlinear movement
+                float& timer = batch.mTimer[i];
+                float sin_t, cos_t;
+                SinCos(timer, sin_t, cos_t);
+                x += vx * dt * cos_t;
+                y += vy * dt * sin_t;
+                timer += dt;
+                if (timer >= sincos_poly::TWO_PI)
+                    timer -= sincos_poly::TWO_PI;
+            }
+            else
+            {
+                x += vx * dt;
+                y += vy * dt;
+            }
+
+            float delta_x = batch.mDeltaX[i];
+            float delta_y = batch.mDeltaY[i];
+            float radius = batch.mRadius[i];
+            if (x < bounds.mMinX + delta_x)
+            {
+                x = std::abs(x);
+                vx *= -1;
+            }
+            if (y < bounds.mMinY + delta_y)
+            {
+                y = std::abs(y);
+                vy *= -1;
+            }
+            if (x + radius > bounds.mMaxX + delta_x)
+            {
+                x = bounds.mMaxX - std::abs(bounds.mMaxX - x);
+                vx *= -1;
+            }
+            if (y + radius > bounds.mMaxY + delta_y)
+            {
+                y = bounds.mMaxY - std::abs(bounds.mMaxY - y);
+                vy *= -1;
+            }
+        }
+    }
+
+    void MoveScalar(const MoveBatch& batch, float dt, const Bounds& bounds)
+    {
+        MoveScalarRange(batch, 0, dt, bounds);
+    }
+
+#if SIM_X86
+    namespace
+    {
+        inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        // Sine and cosine of four angles. Polynomial approximation with the reduction by quadrants.
+        inline void SinCos(__m128 angle, __m128& sin_out, __m128& cos_out)
+        {
+            using namespace sincos_poly;
+            const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+            // Sine is odd, so the sign of the angle goes to the sine sign
+            __m128 sin_sign = _mm_and_ps(angle, sign_mask);
+            __m128 x = _mm_andnot_ps(sign_mask, angle);
+
+            // Even octant number j and reduction of the angle to [-PI/4, PI/4]
+            __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOUR_OVER_PI)));
+            j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+            __m128 y = _mm_cvtepi32_ps(j);
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP1)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP2)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP3)));
+
+            // In the octants 2 and 6 sine and cosine change places
+            __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_set1_epi32(2)));
+            // Sine is negative in the octants 4 and 6, cosine in the octants 2 and 4
+            sin_sign = _mm_xor_ps(sin_sign, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29)));
+            __m128 cos_sign = _mm_castsi128_ps(
+                _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+
+            __m128 z = _mm_mul_ps(x, x);
+            __m128 poly_cos = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(C1), z), _mm_set1_ps(C2));
+            poly_cos = _mm_add_ps(_mm_mul_ps(poly_cos, z), _mm_set1_ps(C3));
+            poly_cos = _mm_mul_ps(_mm_mul_ps(poly_cos, z), z);
+            poly_cos = _mm_sub_ps(poly_cos, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+            poly_cos = _mm_add_ps(poly_cos, _mm_set1_ps(1.0f));
+
+            __m128 poly_sin = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(S1), z), _mm_set1_ps(S2));
+            poly_sin = _mm_add_ps(_mm_mul_ps(poly_sin, z), _mm_set1_ps(S3));
+            poly_sin = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(poly_sin, z), x), x);
+
+            sin_out = _mm_xor_ps(Select(swap, poly_cos, poly_sin), sin_sign);
+            cos_out = _mm_xor_ps(Select(swap, poly_sin, poly_cos), cos_sign);
+        }
+
+        // Reflection of the coordinate from the lower bound: x = |x|, vx = -vx
+        inline void ReflectMin(__m128& x, __m128& v, __m128 limit)
+        {
+            const __m128 sign_mask = _mm_set1_ps(-0.0f);
+            __m128 mask = _mm_cmplt_ps(x, limit);
+            x = Select(mask, _mm_andnot_ps(sign_mask, x), x);
+            v = _mm_xor_ps(v, _mm_and_ps(mask, sign_mask));
+        }
+
+        // Reflection of the coordinate from the upper bound if the edge is beyond the limit:
+        // x = max - |max - x|, vx = -vx
+        inline void ReflectMax(__m128& x, __m128& v, __m128 edge, __m128 limit, __m128 max)
+        {
+            const __m128 sign_mask = _mm_set1_ps(-0.0f);
+            __m128 mask = _mm_cmpgt_ps(edge, limit);
+            __m128 reflected = _mm_sub_ps(max, _mm_andnot_ps(sign_mask, _mm_sub_ps(max, x)));
+            x = Select(mask, reflected, x);
+            v = _mm_xor_ps(v, _mm_and_ps(mask, sign_mask));
+        }
+    }
+
+    void MoveSse2(const MoveBatch& batch, float dt, const Bounds& bounds)
+    {
+        const __m128 step = _mm_set1_ps(dt);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two_pi = _mm_set1_ps(sincos_poly::TWO_PI);
+        const __m128 min_x = _mm_set1_ps(bounds.mMinX);
+        const __m128 min_y = _mm_set1_ps(bounds.mMinY);
+        const __m128 max_x = _mm_set1_ps(bounds.mMaxX);
+        const __m128 max_y = _mm_set1_ps(bounds.mMaxY);
+
+        size_t i = 0;
+        for (; i + 4 <= batch.mCount; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(batch.mX + i);
+            __m128 y = _mm_loadu_ps(batch.mY + i);
+            __m128 vx = _mm_loadu_ps(batch.mVx + i);
+            __m128 vy = _mm_loadu_ps(batch.mVy + i);
+            __m128 nonlinear = _mm_loadu_ps(batch.mNonlinear + i);
+
+            // Factors of the nonlinear movement. For the linear movement they are equal to 1.
+            __m128 factor_x = one;
+            __m128 factor_y = one;
+            __m128 is_nonlinear = _mm_cmpgt_ps(nonlinear, _mm_setzero_ps());
+            if (_mm_movemask_ps(is_nonlinear))
+            {
+                __m128 timer = _mm_loadu_ps(batch.mTimer + i);
+                __m128 sin_t, cos_t;
+                SinCos(timer, sin_t, cos_t);
+                factor_x = _mm_add_ps(one, _mm_mul_ps(nonlinear, _mm_sub_ps(cos_t, one)));
+                factor_y = _mm_add_ps(one, _mm_mul_ps(nonlinear, _mm_sub_ps(sin_t, one)));
+
+                timer = _mm_add_ps(timer, _mm_and_ps(is_nonlinear, step));
+                timer = _mm_sub_ps(timer, _mm_and_ps(_mm_cmpge_ps(timer, two_pi), two_pi));
+                _mm_storeu_ps(batch.mTimer + i, timer);
+            }
+            x = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(vx, step), factor_x));
+            y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(vy, step), factor_y));
+
+            __m128 delta_x = _mm_loadu_ps(batch.mDeltaX + i);
+            __m128 delta_y = _mm_loadu_ps(batch.mDeltaY + i);
+            __m128 radius = _mm_loadu_ps(batch.mRadius + i);
+            ReflectMin(x, vx, _mm_add_ps(min_x, delta_x));
+            ReflectMin(y, vy, _mm_add_ps(min_y, delta_y));
+            ReflectMax(x, vx, _mm_add_ps(x, radius), _mm_add_ps(max_x, delta_x), max_x);
+            ReflectMax(y, vy, _mm_add_ps(y, radius), _mm_add_ps(max_y, delta_y), max_y);
+
+            _mm_storeu_ps(batch.mX + i, x);
+            _mm_storeu_ps(batch.mY + i, y);
+            _mm_storeu_ps(batch.mVx + i, vx);
+            _mm_storeu_ps(batch.mVy + i, vy);
+        }
+
+        MoveScalarRange(batch, i, dt, bounds);
+    }
+#else
+    void MoveSse2(const MoveBatch& batch, float dt, const Bounds& bounds)
+    {
+        MoveScalar(batch, dt, bounds);
+    }
+#endif
+
+    bool IsSimdBuilt(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::SSE2:
+            return SIM_X86 != 0;
+        case SimdLevel::AVX2:
+            return Avx2KernelBuilt();
+        default:
+            return true;
+        }
+    }
+
+    SimdLevel DetectSimd()
+    {
+#if SIM_X86
+        bool avx2 = false;
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7)
+        {
+            __cpuid(info, 1);
+            // The processor supports AVX and the system saves the AVX registers
+            bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+            __cpuidex(info, 7, 0);
+            avx2 = os_avx && (info[1] & (1 << 5));
+        }
+#else
+        __builtin_cpu_init();
+        avx2 = __builtin_cpu_supports("avx2");
+#endif
+        if (avx2 && IsSimdBuilt(SimdLevel::AVX2))
+            return SimdLevel::AVX2;
+
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    bool IsSimdSupported(SimdLevel level)
+    {
+        // The levels are ordered, so the best supported one allows all lower ones
+        static const SimdLevel detected = DetectSimd();
+        return level >= SimdLevel::SCALAR && level <= detected;
+    }
+
+    MoveKernel SelectMoveKernel(SimdLevel level)
+    {
+        if (!IsSimdSupported(level))
+            level = DetectSimd();
+        if (!IsSimdBuilt(level))
+            return MoveScalar;
+
+        switch (level)
+        {
+        case SimdLevel::SSE2:
+            return MoveSse2;
+        case SimdLevel::AVX2:
+            return MoveAvx2;
+        default:
+            return MoveScalar;
+        }
+    }
+
+    const char* SimdName(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+        }
+    }
+}
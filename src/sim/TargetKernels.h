@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Kernels of the movement of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include "SimTypes.h"
+#include "Targets.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SIM_X86 1
+#else
+#define SIM_X86 0
+#endif
+
+namespace sim
+{
+    // Instruction set used by the kernels
+    enum class SimdLevel
+    {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    // Arrays of the targets processed by the movement kernel
+    struct MoveBatch
+    {
+        float* mX;
+        float* mY;
+        float* mVx;
+        float* mVy;
+        float* mTimer;
+        const float* mRadius;
+        const float* mDeltaX;
+        const float* mDeltaY;
+        // Share of the nonlinear movement: 1 for the nonlinear movement, 0 for the linear one
+        const float* mNonlinear;
+        size_t mCount;
+    };
+
+    // Integration of the positions and reflection of the velocities at the bounds for all targets of the batch.
+    // The timer of the nonlinear movement is kept in [0, 2 * PI).
+    using MoveKernel = void (*)(const MoveBatch& batch, float dt, const Bounds& bounds);
+
+    void MoveScalar(const MoveBatch& batch, float dt, const Bounds& bounds);
+    void MoveSse2(const MoveBatch& batch, float dt, const Bounds& bounds);
+    void MoveAvx2(const MoveBatch& batch, float dt, const Bounds& bounds);
+
+    // Scalar movement of the targets from first to count. Used for the tails of the vector kernels.
+    void MoveScalarRange(const MoveBatch& batch, size_t first, float dt, const Bounds& bounds);
+
+    // Whether the kernel for the level is compiled in
+    bool IsSimdBuilt(SimdLevel level);
+
+    // Best instruction set supported by the processor and compiled in
+    SimdLevel DetectSimd();
+
+    // Whether the level is one of SimdLevel and the processor can run its kernel
+    bool IsSimdSupported(SimdLevel level);
+
+    // Kernel for the level. Falls back to the best supported level if the processor can't run the kernel
+    // or it isn't compiled in.
+    MoveKernel SelectMoveKernel(SimdLevel level);
+
+    const char* SimdName(SimdLevel level);
+}
@@ -0,0 +1,156 @@
+/**
+ * \file
+ * \brief AVX2 kernel of the movement of the targets.
+ * The file is compiled with the AVX2 instructions enabled, the kernel is called only if the processor supports them.
+ * \author Maksimovskiy A.S.
+ */
+
+#include "SinCosPoly.h"
+#include "TargetKernels.h"
+
+#if SIM_X86 && (defined(__AVX2__) || defined(_MSC_VER))
+#define SIM_AVX2_KERNEL 1
+#include <immintrin.h>
+#else
+#define SIM_AVX2_KERNEL 0
+#endif
+
+namespace sim
+{
+    bool Avx2KernelBuilt()
+    {
+        return SIM_AVX2_KERNEL != 0;
+    }
+
+#if SIM_AVX2_KERNEL
+    namespace
+    {
+        inline __m256 Select(__m256 mask, __m256 a, __m256 b)
+        {
+            return _mm256_blendv_ps(b, a, mask);
+        }
+
+        // Sine and cosine of eight angles. Polynomial approximation with the reduction by quadrants.
+        inline void SinCos(__m256 angle, __m256& sin_out, __m256& cos_out)
+        {
+            using namespace sincos_poly;
+            const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+
+            // Sine is odd, so the sign of the angle goes to the sine sign
+            __m256 sin_sign = _mm256_and_ps(angle, sign_mask);
+            __m256 x = _mm256_andnot_ps(sign_mask, angle);
+
+            // Even octant number j and reduction of the angle to [-PI/4, PI/4]
+            __m256i j = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(FOUR_OVER_PI)));
+            j = _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+            __m256 y = _mm256_cvtepi32_ps(j);
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP1)));
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP2)));
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(DP3)));
+
+            // In the octants 2 and 6 sine and cosine change places
+            __m256 swap = _mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(_mm256_and_si256(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(2)));
+            // Sine is negative in the octants 4 and 6, cosine in the octants 2 and 4
+            sin_sign = _mm256_xor_ps(sin_sign,
+                _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, _mm256_set1_epi32(4)), 29)));
+            __m256 cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(
+                _mm256_and_si256(_mm256_add_epi32(j, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+
+            __m256 z = _mm256_mul_ps(x, x);
+            __m256 poly_cos = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(C1), z), _mm256_set1_ps(C2));
+            poly_cos = _mm256_add_ps(_mm256_mul_ps(poly_cos, z), _mm256_set1_ps(C3));
+            poly_cos = _mm256_mul_ps(_mm256_mul_ps(poly_cos, z), z);
+            poly_cos = _mm256_sub_ps(poly_cos, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+            poly_cos = _mm256_add_ps(poly_cos, _mm256_set1_ps(1.0f));
+
+            __m256 poly_sin = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(S1), z), _mm256_set1_ps(S2));
+            poly_sin = _mm256_add_ps(_mm256_mul_ps(poly_sin, z), _mm256_set1_ps(S3));
+            poly_sin = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(poly_sin, z), x), x);
+
+            sin_out = _mm256_xor_ps(Select(swap, poly_cos, poly_sin), sin_sign);
+            cos_out = _mm256_xor_ps(Select(swap, poly_sin, poly_cos), cos_sign);
+        }
+
+        // Reflection of the coordinate from the lower bound: x = |x|, vx = -vx
+        inline void ReflectMin(__m256& x, __m256& v, __m256 limit)
+        {
+            const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+            __m256 mask = _mm256_cmp_ps(x, limit, _CMP_LT_OQ);
+            x = Select(mask, _mm256_andnot_ps(sign_mask, x), x);
+            v = _mm256_xor_ps(v, _mm256_and_ps(mask, sign_mask));
+        }
+
+        // Reflection of the coordinate from the upper bound if the edge is beyond the limit:
+        // x = max - |max - x|, vx = -vx
+        inline void ReflectMax(__m256& x, __m256& v, __m256 edge, __m256 limit, __m256 max)
+        {
+            const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+            __m256 mask = _mm256_cmp_ps(edge, limit, _CMP_GT_OQ);
+            __m256 reflected = _mm256_sub_ps(max, _mm256_andnot_ps(sign_mask, _mm256_sub_ps(max, x)));
+            x = Select(mask, reflected, x);
+            v = _mm256_xor_ps(v, _mm256_and_ps(mask, sign_mask));
+        }
+    }
+
+    void MoveAvx2(const MoveBatch& batch, float dt, const Bounds& bounds)
+    {
+        const __m256 step = _mm256_set1_ps(dt);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 two_pi = _mm256_set1_ps(sincos_poly::TWO_PI);
+        const __m256 min_x = _mm256_set1_ps(bounds.mMinX);
+        const __m256 min_y = _mm256_set1_ps(bounds.mMinY);
+        const __m256 max_x = _mm256_set1_ps(bounds.mMaxX);
+        const __m256 max_y = _mm256_set1_ps(bounds.mMaxY);
+
+        size_t i = 0;
+        for (; i + 8 <= batch.mCount; i += 8)
+        {
+            __m256 x = _mm256_loadu_ps(batch.mX + i);
+            __m256 y = _mm256_loadu_ps(batch.mY + i);
+            __m256 vx = _mm256_loadu_ps(batch.mVx + i);
+            __m256 vy = _mm256_loadu_ps(batch.mVy + i);
+            __m256 nonlinear = _mm256_loadu_ps(batch.mNonlinear + i);
+
+            // Factors of the nonlinear movement. For the linear movement they are equal to 1.
+            __m256 factor_x = one;
+            __m256 factor_y = one;
+            __m256 is_nonlinear = _mm256_cmp_ps(nonlinear, _mm256_setzero_ps(), _CMP_GT_OQ);
+            if (_mm256_movemask_ps(is_nonlinear))
+            {
+                __m256 timer = _mm256_loadu_ps(batch.mTimer + i);
+                __m256 sin_t, cos_t;
+                SinCos(timer, sin_t, cos_t);
+                factor_x = _mm256_add_ps(one, _mm256_mul_ps(nonlinear, _mm256_sub_ps(cos_t, one)));
+                factor_y = _mm256_add_ps(one, _mm256_mul_ps(nonlinear, _mm256_sub_ps(sin_t, one)));
+
+                timer = _mm256_add_ps(timer, _mm256_and_ps(is_nonlinear, step));
+                timer = _mm256_sub_ps(timer, _mm256_and_ps(_mm256_cmp_ps(timer, two_pi, _CMP_GE_OQ), two_pi));
+                _mm256_storeu_ps(batch.mTimer + i, timer);
+            }
+            x = _mm256_add_ps(x, _mm256_mul_ps(_mm256_mul_ps(vx, step), factor_x));
+            y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_mul_ps(vy, step), factor_y));
+
+            __m256 delta_x = _mm256_loadu_ps(batch.mDeltaX + i);
+            __m256 delta_y = _mm256_loadu_ps(batch.mDeltaY + i);
+            __m256 radius = _mm256_loadu_ps(batch.mRadius + i);
+            ReflectMin(x, vx, _mm256_add_ps(min_x, delta_x));
+            ReflectMin(y, vy, _mm256_add_ps(min_y, delta_y));
+            ReflectMax(x, vx, _mm256_add_ps(x, radius), _mm256_add_ps(max_x, delta_x), max_x);
+            ReflectMax(y, vy, _mm256_add_ps(y, radius), _mm256_add_ps(max_y, delta_y), max_y);
+
+            _mm256_storeu_ps(batch.mX + i, x);
+            _mm256_storeu_ps(batch.mY + i, y);
+            _mm256_storeu_ps(batch.mVx + i, vx);
+            _mm256_storeu_ps(batch.mVy + i, vy);
+        }
+
+        MoveScalarRange(batch, i, dt, bounds);
+    }
+#else
+    void MoveAvx2(const MoveBatch& batch, float dt, const Bounds& bounds)
+    {
+        MoveScalar(batch, dt, bounds);
+    }
+#endif
+}
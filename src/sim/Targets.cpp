@@ -0,0 +1,389 @@
+/**
+ * \file
+ * \brief Implementation of the targets physics
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Profiler.h"
+#include "TargetKernels.h"
+#include "Targets.h"
+#include "ThreadPool.h"
+
+namespace sim
+{
+    // Target interaction ratio
+    const float FORCE_K = 50;
+    // With fewer targets the bullet checks all of them without the grid
+    const size_t HIT_GRID_MIN_TARGETS = 64;
+    // Widening of the search around a bullet in the grid built before the movement, covers the rounding of the positions
+    const float GRID_SHIFT_MARGIN = 1.0f;
+    // With fewer targets the interaction isn't split between threads
+    const size_t PARALLEL_MIN_TARGETS = 4096;
+
+    TargetSystem::TargetSystem() :
+        mMoveKernel(SelectMoveKernel(DetectSimd())),
+        mPool(nullptr),
+        mGridState(GridState::INVALID),
+        mMaxRadius(0.0f),
+        mGridShift(-1.0f)
+    {
+    }
+
+    void TargetSystem::SetSimdLevel(SimdLevel level)
+    {
+        mMoveKernel = SelectMoveKernel(level);
+    }
+
+    void TargetSystem::SetThreadPool(ThreadPool* pool)
+    {
+        mPool = pool;
+    }
+
+    void TargetSystem::Interaction(size_t first, size_t second, float dt)
+    {
+        float x1 = mX[first];
+        float y1 = mY[first];
+        float x2 = mX[second];
+        float y2 = mY[second];
+        float r1 = mRadius[first];
+        float r2 = mRadius[second];
+
+        // Distance between targets
+        float d = std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+
+        // If the distance is greater than the sum of the size of the targets, then there is no interaction.
+        // Targets in the same point have no direction of the force.
+        if (d >= r1 + r2 || d <= 0.0f)
+            return;
+
+        // Calculation of changes in the projections of the speed of both targets.
+        // F - the sum of the forces acting on the body. Accepted that this is the force of elasticity.
+        // Formula: F = k * delta_x, where delta_x is the displacement during elastic impact.
+        // a = F / m, where a is acceleration, m is body mass.
+        // Suppose that the mass is linearly dependent on the size, and approximately m ~r
+        // Substituting everything, a = k * delta_x / r
+        // Projections: ax = a * (x1 - x2) / d, where d is the distance between the targets
+        //              ay = a * (y1 - y2) / d
+        float f = FORCE_K * (r1 + r2 - d);
+        mVx[first] += f * (x1 - x2) / d / r1 * dt;
+        mVy[first] += f * (y1 - y2) / d / r1 * dt;
+        mVx[second] -= f * (x1 - x2) / d / r2 * dt;
+        mVy[second] -= f * (y1 - y2) / d / r2 * dt;
+    }
+
+    void TargetSystem::Impulse(size_t first, size_t second, float dt, float& dvx, float& dvy) const
+    {
+        float x1 = mX[first];
+        float y1 = mY[first];
+        float x2 = mX[second];
+        float y2 = mY[second];
+        float r1 = mRadius[first];
+        float r2 = mRadius[second];
+
+        float d = std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+        if (d >= r1 + r2 || d <= 0.0f)
+            return;
+
+        // The same force as in Interaction, applied to the first target only
+        float f = FORCE_K * (r1 + r2 - d);
+        dvx += f * (x1 - x2) / d / r1 * dt;
+        dvy += f * (y1 - y2) / d / r1 * dt;
+    }
+
+    bool TargetSystem::IsHit(size_t index, const Vec2& other, int size, float vx, float vy) const
+    {
+        float x = mX[index];
+        float y = mY[index];
+
+        // Distance between target and bullet
+        float d = std::sqrt((x - other.x) * (x - other.x) + (y - other.y) * (y - other.y));
+
+        // If the distance is greater than the target size, then there is no interaction
+        if (d >= mRadius[index])
+            return false;
+
+        // The equation of a line whose direction vector is (vx, vy)
+        // will be vy * x - vx * y + (vx * other.y + vy * other.x) = 0.
+        // Therefore, it is necessary to check that the target point lies approximately on this straight line.
+        float c = vx * other.y + vy * other.x;
+        float koeff = vx * y / (vy * x + c);
+        return std::abs(koeff) <= size;
+    }
+
+    void TargetSystem::BuildGrid()
+    {
+        if (mGridState == GridState::CURRENT)
+            return;
+
+        mMaxRadius = 0.0f;
+        for (float radius : mRadius)
+            mMaxRadius = std::max(mMaxRadius, radius);
+
+        // Targets interact only if the distance is less than the sum of their sizes
+        mGrid.Build(Size(), 2.0f * mMaxRadius, [this](size_t i) { return Vec2{ mX[i], mY[i] }; });
+        mGridState = GridState::CURRENT;
+    }
+
+    float TargetSystem::GridShift()
+    {
+        if (mGridShift >= 0.0f)
+            return mGridShift;
+
+        float shift = 0.0f;
+        for (size_t i = 0; i < Size(); i++)
+        {
+            shift = std::max(shift, std::abs(mX[i] - mPrevX[i]));
+            shift = std::max(shift, std::abs(mY[i] - mPrevY[i]));
+        }
+        mGridShift = shift + GRID_SHIFT_MARGIN;
+        return mGridShift;
+    }
+
+    void TargetSystem::Spawn(const TargetDesc& desc, const Vec2& point, const Vec2& velocity)
+    {
+        mGridState = GridState::INVALID;
+        mX.push_back(point.x);
+        mY.push_back(point.y);
+        mPrevX.push_back(point.x);
+        mPrevY.push_back(point.y);
+        mVx.push_back(velocity.x);
+        mVy.push_back(velocity.y);
+        mRadius.push_back(desc.mRadius);
+        mDeltaX.push_back(desc.mDeltaX);
+        mDeltaY.push_back(desc.mDeltaY);
+        mHP.push_back(desc.mHP);
+        mArchetype.push_back(desc.mArchetype);
+        mTimer.push_back(0.0f);
+        mNonlinear.push_back(desc.mMovement == Movement::NONLINEAR ? 1.0f : 0.0f);
+    }
+
+    void TargetSystem::Spawn(const TargetDesc& desc, const float* x, const float* y,
+                             const float* vx, const float* vy, size_t count)
+    {
+        mGridState = GridState::INVALID;
+        size_t size = Size() + count;
+        mX.insert(mX.end(), x, x + count);
+        mY.insert(mY.end(), y, y + count);
+        mPrevX.insert(mPrevX.end(), x, x + count);
+        mPrevY.insert(mPrevY.end(), y, y + count);
+        mVx.insert(mVx.end(), vx, vx + count);
+        mVy.insert(mVy.end(), vy, vy + count);
+        mRadius.resize(size, desc.mRadius);
+        mDeltaX.resize(size, desc.mDeltaX);
+        mDeltaY.resize(size, desc.mDeltaY);
+        mHP.resize(size, desc.mHP);
+        mArchetype.resize(size, desc.mArchetype);
+        mTimer.resize(size, 0.0f);
+        mNonlinear.resize(size, desc.mMovement == Movement::NONLINEAR ? 1.0f : 0.0f);
+    }
+
+    void TargetSystem::Reserve(size_t count)
+    {
+        mX.reserve(count);
+        mY.reserve(count);
+        mPrevX.reserve(count);
+        mPrevY.reserve(count);
+        mVx.reserve(count);
+        mVy.reserve(count);
+        mRadius.reserve(count);
+        mDeltaX.reserve(count);
+        mDeltaY.reserve(count);
+        mHP.reserve(count);
+        mArchetype.reserve(count);
+        mTimer.reserve(count);
+        mNonlinear.reserve(count);
+        mDvx.reserve(count);
+        mDvy.reserve(count);
+        mGrid.Reserve(count);
+    }
+
+    void TargetSystem::CalcInteractions(float dt)
+    {
+        PROFILE_ZONE("TargetInteractions");
+        if (mPool && mPool->Size() > 1 && Size() >= PARALLEL_MIN_TARGETS)
+        {
+            CalcInteractionsParallel(dt, *mPool);
+            return;
+        }
+
+        BuildGrid();
+
+        // Each pair is handled once, so it gets the impulse of both orders of interaction
+        float pair_dt = 2.0f * dt;
+        mGrid.ForEachPair([this, pair_dt](size_t i, size_t j)
+        {
+            Interaction(i, j, pair_dt);
+        });
+    }
+
+    void TargetSystem::CalcInteractionsParallel(float dt, ThreadPool& pool)
+    {
+        BuildGrid();
+
+        // Every pair is seen from both targets, so each side gets the impulse of both orders of interaction
+        float pair_dt = 2.0f * dt;
+        mDvx.assign(Size(), 0.0f);
+        mDvy.assign(Size(), 0.0f);
+
+        // The targets are taken in the order of the cells, so each thread works with a compact area
+        pool.ParallelFor(Size(), [this, pair_dt](size_t begin, size_t end)
+        {
+            for (size_t position = begin; position < end; position++)
+            {
+                size_t i = mGrid.SortedObject(position);
+                float dvx = 0.0f;
+                float dvy = 0.0f;
+                mGrid.ForEachAround(i, [&](size_t j)
+                {
+                    if (j != i)
+                        Impulse(i, j, pair_dt, dvx, dvy);
+                });
+                mDvx[i] = dvx;
+                mDvy[i] = dvy;
+            }
+        });
+
+        for (size_t i = 0; i < Size(); i++)
+        {
+            mVx[i] += mDvx[i];
+            mVy[i] += mDvy[i];
+        }
+    }
+
+    void TargetSystem::CalcInteractionsBruteForce(float dt)
+    {
+        float pair_dt = 2.0f * dt;
+        for (size_t i = 0; i < Size(); i++)
+            for (size_t j = i + 1; j < Size(); j++)
+                Interaction(i, j, pair_dt);
+    }
+
+    void TargetSystem::Move(float dt, const Bounds& bounds)
+    {
+        PROFILE_ZONE("TargetMove");
+        // The grid of the positions before the movement is still used by the hit check
+        mGridState = mGridState == GridState::CURRENT ? GridState::PREVIOUS : GridState::INVALID;
+        mGridShift = -1.0f;
+        mPrevX = mX;
+        mPrevY = mY;
+        MoveBatch batch{ mX.data(), mY.data(), mVx.data(), mVy.data(), mTimer.data(),
+                         mRadius.data(), mDeltaX.data(), mDeltaY.data(), mNonlinear.data(), Size() };
+        mMoveKernel(batch, dt, bounds);
+    }
+
+    bool TargetSystem::CheckHit(const Vec2& point, int size, float vx, float vy, int damage)
+    {
+        size_t index = FindHit(point, size, vx, vy);
+        if (index == NO_TARGET)
+            return false;
+
+        // Reduce the number of target lives depending on bullet damage
+        mHP[index] -= damage;
+        return true;
+    }
+
+    size_t TargetSystem::FindHit(const Vec2& point, int size, float vx, float vy)
+    {
+        if (Size() < HIT_GRID_MIN_TARGETS)
+            return FindHitLinear(point, size, vx, vy);
+
+        // The grid built by the interaction before the movement is reused, so it isn't built again for the bullets.
+        // A hit target is within its radius of the bullet now, so it was within the radius and the shift before.
+        float radius = 0.0f;
+        if (mGridState == GridState::PREVIOUS)
+            radius = mMaxRadius + GridShift();
+        else
+        {
+            BuildGrid();
+            radius = mMaxRadius;
+        }
+
+        // The first target in the order of storage is hit, as in the check of every target
+        size_t first = NO_TARGET;
+        mGrid.ForEachNear(point, radius, [&](size_t i)
+        {
+            if (i < first && IsHit(i, point, size, vx, vy))
+                first = i;
+        });
+        return first;
+    }
+
+    size_t TargetSystem::FindHitLinear(const Vec2& point, int size, float vx, float vy) const
+    {
+        for (size_t i = 0; i < Size(); i++)
+        {
+            if (IsHit(i, point, size, vx, vy))
+                return i;
+        }
+
+        return NO_TARGET;
+    }
+
+    void TargetSystem::Remove(size_t index)
+    {
+        mGridState = GridState::INVALID;
+        size_t last = Size() - 1;
+        mX[index] = mX[last];
+        mY[index] = mY[last];
+        mPrevX[index] = mPrevX[last];
+        mPrevY[index] = mPrevY[last];
+        mVx[index] = mVx[last];
+        mVy[index] = mVy[last];
+        mRadius[index] = mRadius[last];
+        mDeltaX[index] = mDeltaX[last];
+        mDeltaY[index] = mDeltaY[last];
+        mHP[index] = mHP[last];
+        mArchetype[index] = mArchetype[last];
+        mTimer[index] = mTimer[last];
+        mNonlinear[index] = mNonlinear[last];
+
+        mX.pop_back();
+        mY.pop_back();
+        mPrevX.pop_back();
+        mPrevY.pop_back();
+        mVx.pop_back();
+        mVy.pop_back();
+        mRadius.pop_back();
+        mDeltaX.pop_back();
+        mDeltaY.pop_back();
+        mHP.pop_back();
+        mArchetype.pop_back();
+        mTimer.pop_back();
+        mNonlinear.pop_back();
+    }
+
+    void TargetSystem::DeleteDead()
+    {
+        PROFILE_ZONE("DeleteDead");
+        size_t i = 0;
+        while (i < Size())
+        {
+            // The moved last target must be checked too, so the index isn't increased
+            if (mHP[i] <= 0)
+                Remove(i);
+            else
+                i++;
+        }
+    }
+
+    void TargetSystem::Clear()
+    {
+        mGridState = GridState::INVALID;
+        mX.clear();
+        mY.clear();
+        mPrevX.clear();
+        mPrevY.clear();
+        mVx.clear();
+        mVy.clear();
+        mRadius.clear();
+        mDeltaX.clear();
+        mDeltaY.clear();
+        mHP.clear();
+        mArchetype.clear();
+        mTimer.clear();
+        mNonlinear.clear();
+    }
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Headless state and physics of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "Grid.h"
+#include "Memory.h"
+#include "SimTypes.h"
+
+namespace sim
+{
+    // Array of an attribute of the targets
+    template <class T>
+    using TargetArray = TrackedVector<T, MemTag::TARGETS>;
+
+    // Movement of the target
+    enum class Movement : uint8_t
+    {
+        // Straight line with the constant velocity
+        LINEAR,
+        // The velocity projections are multiplied by the cosine and sine of the time
+        NONLINEAR
+    };
+
+    // Attributes shared by all targets of one kind
+    struct TargetDesc
+    {
+        // Index of the archetype of the target. The simulation only keeps it, the presenter draws the target by it.
+        uint16_t mArchetype;
+
+        Movement mMovement;
+
+        // Size
+        float mRadius;
+
+        // Coordinate adjustment
+        float mDeltaX;
+        float mDeltaY;
+
+        // Hit points
+        int mHP;
+
+        // Range of the initial velocity projections
+        float mMinSpeed;
+        float mMaxSpeed;
+    };
+
+    enum class SimdLevel;
+    struct MoveBatch;
+    class ThreadPool;
+
+    // Storage and physics of all targets.
+    // Each attribute of the targets is stored in a separate array, the target is an index in these arrays.
+    class TargetSystem
+    {
+    public:
+        // Index meaning that no target is found
+        static const size_t NO_TARGET = static_cast<size_t>(-1);
+
+        TargetSystem();
+
+        // Choosing the instruction set of the movement. By default the best supported one is used.
+        void SetSimdLevel(SimdLevel level);
+
+        // Threads for the interaction of many targets. Without the pool everything is calculated on the calling thread.
+        void SetThreadPool(ThreadPool* pool);
+
+        // Adding a new target
+        void Spawn(const TargetDesc& desc, const Vec2& point, const Vec2& velocity);
+
+        // Adding count targets of one kind with the positions and velocities from the arrays
+        void Spawn(const TargetDesc& desc, const float* x, const float* y, const float* vx, const float* vy, size_t count);
+
+        // Calculation of the interaction of all targets with each other.
+        // Only targets from the neighbouring cells of the grid are checked.
+        // With the pool of threads many targets are processed in parallel.
+        void CalcInteractions(float dt);
+
+        // Parallel calculation of the interaction. Each thread sums the velocity changes of its own targets
+        // from all their neighbours, so the threads don't write to the same target.
+        // The result doesn't depend on the count of threads.
+        void CalcInteractionsParallel(float dt, ThreadPool& pool);
+
+        // Calculation of the interaction by checking every pair of targets.
+        // Reference implementation for the grid version.
+        void CalcInteractionsBruteForce(float dt);
+
+        // Movement of all targets inside the bounds. The positions before the movement are kept.
+        // Several targets are processed at once by the vector instructions.
+        void Move(float dt, const Bounds& bounds);
+
+        // Checking the hit of a bullet with a position at the point for any of the targets.
+        // Only the first hit target loses its hit points.
+        bool CheckHit(const Vec2& point, int size, float vx, float vy, int damage);
+
+        // Index of the first target hit by the bullet or NO_TARGET.
+        // Only the targets from the cells of the grid near the bullet are checked. The grid built by
+        // the interaction before the last movement is used, if there is one.
+        size_t FindHit(const Vec2& point, int size, float vx, float vy);
+
+        // Index of the first target hit by the bullet by checking every target.
+        // Reference implementation for the grid version.
+        size_t FindHitLinear(const Vec2& point, int size, float vx, float vy) const;
+
+        // Method to remove all dead targets.
+        // The last target takes the place of the removed one, so the order of the targets changes.
+        void DeleteDead();
+
+        // Reserving the memory for count targets, so spawning up to them doesn't allocate
+        void Reserve(size_t count);
+
+        size_t Size() const { return mX.size(); }
+
+        bool Empty() const { return mX.empty(); }
+
+        void Clear();
+
+        // Target position
+        const TargetArray<float>& X() const { return mX; }
+        const TargetArray<float>& Y() const { return mY; }
+
+        // Target position before the last movement
+        const TargetArray<float>& PrevX() const { return mPrevX; }
+        const TargetArray<float>& PrevY() const { return mPrevY; }
+
+        // Velocity. Projections on the axes of Ox and Oy
+        const TargetArray<float>& VelocityX() const { return mVx; }
+        const TargetArray<float>& VelocityY() const { return mVy; }
+
+        // Size
+        const TargetArray<float>& Radius() const { return mRadius; }
+
+        // Coordinate adjustment
+        const TargetArray<float>& DeltaX() const { return mDeltaX; }
+        const TargetArray<float>& DeltaY() const { return mDeltaY; }
+
+        // Hit points
+        const TargetArray<int>& HP() const { return mHP; }
+
+        // Archetype of the target
+        const TargetArray<uint16_t>& Archetype() const { return mArchetype; }
+    private:
+        // Removing the target by replacing it with the last one
+        void Remove(size_t index);
+
+        void Interaction(size_t first, size_t second, float dt);
+
+        // Change of the velocity of the first target by the second one.
+        // The pair gets the opposite changes, so Interaction is the sum of the changes of both targets.
+        void Impulse(size_t first, size_t second, float dt, float& dvx, float& dvy) const;
+
+        bool IsHit(size_t index, const Vec2& other, int size, float vx, float vy) const;
+
+        // Distribution of the targets by the cells of the grid, if they have moved since the last one
+        void BuildGrid();
+
+        // Maximum movement of the targets along an axis since the grid was built with the previous positions
+        float GridShift();
+
+        TargetArray<float> mX;
+        TargetArray<float> mY;
+        TargetArray<float> mPrevX;
+        TargetArray<float> mPrevY;
+        TargetArray<float> mVx;
+        TargetArray<float> mVy;
+        TargetArray<float> mRadius;
+        TargetArray<float> mDeltaX;
+        TargetArray<float> mDeltaY;
+        TargetArray<int> mHP;
+        TargetArray<uint16_t> mArchetype;
+
+        // Time of the nonlinear movement
+        TargetArray<float> mTimer;
+        // Share of the nonlinear movement: 1 for the nonlinear movement, 0 for the linear one
+        TargetArray<float> mNonlinear;
+
+        // Kernel of the movement for the chosen instruction set
+        void (*mMoveKernel)(const MoveBatch& batch, float dt, const Bounds& bounds);
+
+        // Threads for the interaction, may be null
+        ThreadPool* mPool;
+
+        // Velocity changes of the parallel interaction
+        TargetArray<float> mDvx;
+        TargetArray<float> mDvy;
+
+        // Grid for searching the neighbouring targets
+        UniformGrid mGrid;
+        enum class GridState : uint8_t
+        {
+            INVALID,
+            // The grid corresponds to the current positions of the targets
+            CURRENT,
+            // The grid corresponds to the positions before the last movement
+            PREVIOUS
+        };
+
+        GridState mGridState;
+        // Maximum size of the targets in the grid
+        float mMaxRadius;
+        // Result of GridShift for the last movement, negative until it is calculated
+        float mGridShift;
+    };
+}
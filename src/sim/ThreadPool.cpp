@@ -0,0 +1,101 @@
+/**
+ * \file
+ * \brief Implementation of the pool of threads
+ * \author Maksimovskiy A.S.
+ */
+
+#include "ThreadPool.h"
+
+namespace sim
+{
+    namespace
+    {
+        // Range of the part of [0, count) split into parts
+        void PartRange(size_t count, size_t parts, size_t part, size_t& begin, size_t& end)
+        {
+            begin = count * part / parts;
+            end = count * (part + 1) / parts;
+        }
+    }
+
+    ThreadPool::ThreadPool(size_t thread_count) :
+        mFunc(nullptr),
+        mCount(0),
+        mGeneration(0),
+        mPending(0),
+        mStop(false)
+    {
+        for (size_t i = 1; i < thread_count; i++)
+            mThreads.emplace_back(&ThreadPool::Run, this, i);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mStartCondition.notify_all();
+        for (auto& thread : mThreads)
+            thread.join();
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const RangeFunc& func)
+    {
+        if (mThreads.empty() || count < Size())
+        {
+            func(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFunc = &func;
+            mCount = count;
+            mPending = mThreads.size();
+            mGeneration++;
+        }
+        mStartCondition.notify_all();
+
+        // The calling thread processes the first range
+        size_t begin, end;
+        PartRange(count, Size(), 0, begin, end);
+        func(begin, end);
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDoneCondition.wait(lock, [this]() { return mPending == 0; });
+        mFunc = nullptr;
+    }
+
+    void ThreadPool::Run(size_t index)
+    {
+        size_t generation = 0;
+        while (true)
+        {
+            const RangeFunc* func = nullptr;
+            size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStartCondition.wait(lock, [&]() { return mStop || mGeneration != generation; });
+                if (mStop)
+                    return;
+
+                generation = mGeneration;
+                func = mFunc;
+                count = mCount;
+            }
+
+            size_t begin, end;
+            PartRange(count, Size(), index, begin, end);
+            (*func)(begin, end);
+
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                last = --mPending == 0;
+            }
+            if (last)
+                mDoneCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Pool of threads for the parallel loops of the simulation
+ * \author Maksimovskiy A.S.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sim
+{
+    // Threads waiting for the ranges of a parallel loop.
+    // The calling thread takes part in the loop, so the pool of n threads starts n - 1 ones.
+    class ThreadPool
+    {
+    public:
+        // Range of the loop: func(begin, end)
+        using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+        explicit ThreadPool(size_t thread_count);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Count of the threads processing a loop, including the calling one
+        size_t Size() const { return mThreads.size() + 1; }
+
+        // Splitting [0, count) into one range per thread and waiting until all ranges are processed
+        void ParallelFor(size_t count, const RangeFunc& func);
+    private:
+        void Run(size_t index);
+
+        std::vector<std::thread> mThreads;
+
+        std::mutex mMutex;
+        std::condition_variable mStartCondition;
+        std::condition_variable mDoneCondition;
+
+        // Current loop
+        const RangeFunc* mFunc;
+        size_t mCount;
+        // Number of the loop, so each thread takes every loop once
+        size_t mGeneration;
+        // Threads which haven't finished the current loop yet
+        size_t mPending;
+        bool mStop;
+    };
+}
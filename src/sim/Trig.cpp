@@ -0,0 +1,55 @@
+/**
+ * \file
+ * \brief Calculation of the trigonometric table at compile time
+ * \author Maksimovskiy A.S.
+ */
+
+#include "Trig.h"
+
+namespace sim
+{
+    namespace
+    {
+        constexpr double TABLE_PI = 3.14159265358979323846;
+
+        // Sine by the Taylor series. The angle is reduced to [-PI/2, PI/2] first, where 9 terms give the double precision.
+        constexpr double TaylorSin(double x)
+        {
+            while (x > TABLE_PI)
+                x -= 2.0 * TABLE_PI;
+            if (x > TABLE_PI / 2.0)
+                x = TABLE_PI - x;
+            else if (x < -TABLE_PI / 2.0)
+                x = -TABLE_PI - x;
+
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 10; n++)
+            {
+                term *= -x * x / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr TrigTable MakeTrigTable()
+        {
+            TrigTable table{};
+            for (int i = 0; i < TRIG_TABLE_SIZE + TRIG_TABLE_SIZE / 4 + 1; i++)
+                table.mSin[i] = static_cast<float>(TaylorSin(2.0 * TABLE_PI * i / TRIG_TABLE_SIZE));
+            return table;
+        }
+    }
+
+    extern constexpr TrigTable TRIG_TABLE = MakeTrigTable();
+
+    // The table is really made by the compiler
+    static_assert(TRIG_TABLE.mSin[0] == 0.0f, "sin(0) must be exact");
+    static_assert(TRIG_TABLE.mSin[TRIG_TABLE_SIZE / 4] == 1.0f, "sin(PI/2) must be exact");
+
+    void SinCos(const float* radians, size_t count, float* sin_out, float* cos_out)
+    {
+        for (size_t i = 0; i < count; i++)
+            trig_detail::SinCosSteps(radians[i] * trig_detail::PER_RADIAN, sin_out[i], cos_out[i]);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Sine and cosine by the table calculated at compile time
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sim
+{
+    // Count of the table values for the full circle. A power of two, so the index is wrapped by a mask.
+    const int TRIG_TABLE_SIZE = 1024;
+
+    // Sines of the angles 2 * PI * i / TRIG_TABLE_SIZE. The table is longer than the circle by a quarter and one value,
+    // so the cosine is read as the sine a quarter further and the next value for the interpolation is always there.
+    struct TrigTable
+    {
+        float mSin[TRIG_TABLE_SIZE + TRIG_TABLE_SIZE / 4 + 1];
+    };
+
+    extern const TrigTable TRIG_TABLE;
+
+    namespace trig_detail
+    {
+        // Table values per radian and per degree
+        const float PER_RADIAN = TRIG_TABLE_SIZE / 6.28318530717959f;
+        const float PER_DEGREE = TRIG_TABLE_SIZE / 360.0f;
+
+        // Sine and cosine of the angle in the table steps. The values between the steps are interpolated linearly,
+        // the error is below 5e-6.
+        inline void SinCosSteps(float steps, float& sin_out, float& cos_out)
+        {
+            // Rounding down also for the negative angles
+            int32_t whole = static_cast<int32_t>(steps);
+            whole -= steps < static_cast<float>(whole) ? 1 : 0;
+            float frac = steps - static_cast<float>(whole);
+            int32_t index = whole & (TRIG_TABLE_SIZE - 1);
+
+            const float* sin_value = TRIG_TABLE.mSin + index;
+            const float* cos_value = sin_value + TRIG_TABLE_SIZE / 4;
+            sin_out = sin_value[0] + (sin_value[1] - sin_value[0]) * frac;
+            cos_out = cos_value[0] + (cos_value[1] - cos_value[0]) * frac;
+        }
+    }
+
+    // Sine and cosine of the angle in radians
+    inline void SinCos(float radians, float& sin_out, float& cos_out)
+    {
+        trig_detail::SinCosSteps(radians * trig_detail::PER_RADIAN, sin_out, cos_out);
+    }
+
+    // Sine and cosine of the angle in degrees. Fractions of a degree are supported.
+    inline void SinCosDeg(float degrees, float& sin_out, float& cos_out)
+    {
+        trig_detail::SinCosSteps(degrees * trig_detail::PER_DEGREE, sin_out, cos_out);
+    }
+
+    inline float SinDeg(float degrees)
+    {
+        float sin_value, cos_value;
+        SinCosDeg(degrees, sin_value, cos_value);
+        return sin_value;
+    }
+
+    inline float CosDeg(float degrees)
+    {
+        float sin_value, cos_value;
+        SinCosDeg(degrees, sin_value, cos_value);
+        return cos_value;
+    }
+
+    // Sines and cosines of count angles in radians. The loop has no calls, so it is unrolled and pipelined.
+    void SinCos(const float* radians, size_t count, float* sin_out, float* cos_out);
+}
@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief Implementation of the voices of a sound
+ * \author Maksimovskiy A.S.
+ */
+
+#include "VoicePool.h"
+
+namespace sim
+{
+    const int VoicePool::NO_SOUND;
+
+    VoicePool::VoicePool() :
+        mTakes(0),
+        mStolen(0)
+    {
+    }
+
+    void VoicePool::Init(size_t voices)
+    {
+        // A sound always has a voice to take
+        mVoices.assign(voices > 0 ? voices : 1, Voice{ NO_SOUND, 0 });
+        mTakes = 0;
+        mStolen = 0;
+    }
+
+    size_t VoicePool::Take(int& stolen)
+    {
+        stolen = NO_SOUND;
+
+        // A free voice is taken first, otherwise the oldest one
+        size_t taken = 0;
+        for (size_t i = 0; i < mVoices.size(); i++)
+        {
+            if (mVoices[i].mOrder == 0)
+            {
+                taken = i;
+                break;
+            }
+            if (mVoices[i].mOrder < mVoices[taken].mOrder)
+                taken = i;
+        }
+
+        Voice& voice = mVoices[taken];
+        if (voice.mOrder != 0)
+        {
+            stolen = voice.mHandle;
+            mStolen++;
+        }
+        voice = Voice{ NO_SOUND, ++mTakes };
+        return taken;
+    }
+
+    void VoicePool::Set(size_t voice, int handle)
+    {
+        mVoices[voice].mHandle = handle;
+    }
+
+    size_t VoicePool::Busy() const
+    {
+        size_t busy = 0;
+        for (auto& voice : mVoices)
+        {
+            if (voice.mOrder != 0)
+                busy++;
+        }
+        return busy;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Fixed count of the voices of a sound with the stealing of the oldest one
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdint>
+
+#include "Memory.h"
+
+namespace sim
+{
+    // Voices of one sound. A voice keeps the handle of the sound given by the audio engine while it plays.
+    // The voices are created at once, so playing the sounds doesn't allocate memory. When all voices are busy,
+    // a new sound takes the voice started before all others and the sound of that voice must be stopped.
+    class VoicePool
+    {
+    public:
+        // Handle meaning that there is no sound
+        static const int NO_SOUND = -1;
+
+        VoicePool();
+
+        // Creating the voices. The handles of the previous ones are forgotten.
+        void Init(size_t voices);
+
+        // Voice for a new sound. If all voices are busy, the oldest one is taken and its handle is returned
+        // in stolen, otherwise stolen is NO_SOUND.
+        size_t Take(int& stolen);
+
+        // Handle of the sound started in the taken voice
+        void Set(size_t voice, int handle);
+
+        // Freeing the voices whose sounds have ended or haven't started. IsPlaying gets the handle of the sound.
+        template<class IsPlaying>
+        void Release(IsPlaying is_playing)
+        {
+            for (auto& voice : mVoices)
+            {
+                if (voice.mOrder != 0 && (voice.mHandle == NO_SOUND || !is_playing(voice.mHandle)))
+                    voice = Voice{ NO_SOUND, 0 };
+            }
+        }
+
+        // Count of the busy voices
+        size_t Busy() const;
+
+        size_t Size() const { return mVoices.size(); }
+
+        // Count of the sounds stopped by the newer ones since Init
+        size_t Stolen() const { return mStolen; }
+    private:
+        struct Voice
+        {
+            int mHandle;
+            // Number of the taking of the voice, 0 for the free voices
+            uint64_t mOrder;
+        };
+
+        TrackedVector<Voice, MemTag::AUDIO> mVoices;
+        // Number of the last taking of a voice
+        uint64_t mTakes;
+        size_t mStolen;
+    };
+}
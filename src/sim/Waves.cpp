@@ -0,0 +1,90 @@
+/**
+ * \file
+ * \brief Implementation of the spawning of the targets by waves
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include "Waves.h"
+
+namespace sim
+{
+    WaveSpawner::WaveSpawner() :
+        mPlan{ {}, Bounds{ 0.0f, 0.0f, 0.0f, 0.0f }, 0.0f, 0, 0, 0 },
+        mActive(false),
+        mWave(0),
+        mTime(0.0f)
+    {
+    }
+
+    void WaveSpawner::Start(const WavePlan& plan)
+    {
+        mPlan = plan;
+        mActive = true;
+        mWave = 0;
+        mTime = 0.0f;
+        mPending.assign(plan.mGroups.size(), 0);
+        mSpawn.assign(plan.mGroups.size(), 0);
+    }
+
+    void WaveSpawner::Stop()
+    {
+        mActive = false;
+        std::fill(mPending.begin(), mPending.end(), 0);
+        std::fill(mSpawn.begin(), mSpawn.end(), 0);
+    }
+
+    const TrackedVector<int, MemTag::WAVES>& WaveSpawner::Tick(float dt, size_t alive)
+    {
+        std::fill(mSpawn.begin(), mSpawn.end(), 0);
+        if (!mActive)
+            return mSpawn;
+
+        // The time is counted from the start of the last wave, so it doesn't lose precision in long sessions
+        mTime += dt;
+        while (HasWaves() && (mWave == 0 || mTime >= mPlan.mInterval))
+        {
+            if (mWave > 0)
+                mTime -= mPlan.mInterval;
+            mWave++;
+
+            // All targets of the finite waves are spawned. In the endless mode the queue of all groups
+            // doesn't grow over the limit of the live targets, so the waves missed while it is reached don't pile up.
+            int room = IsEndless() ? std::max(0, mPlan.mMaxAlive - static_cast<int>(Pending())) : INT_MAX;
+            for (size_t i = 0; i < mPlan.mGroups.size(); i++)
+            {
+                int count = std::min(mPlan.mGroups[i].mCount, room);
+                mPending[i] += count;
+                if (IsEndless())
+                    room -= count;
+            }
+
+            if (mPlan.mInterval <= 0.0f)
+                break;
+        }
+
+        int budget = std::min(mPlan.mSpawnBudget, mPlan.mMaxAlive - static_cast<int>(alive));
+        for (size_t i = 0; i < mPending.size() && budget > 0; i++)
+        {
+            mSpawn[i] = std::min(mPending[i], budget);
+            mPending[i] -= mSpawn[i];
+            budget -= mSpawn[i];
+        }
+        return mSpawn;
+    }
+
+    bool WaveSpawner::Done() const
+    {
+        return !mActive || (!HasWaves() && Pending() == 0);
+    }
+
+    size_t WaveSpawner::Pending() const
+    {
+        size_t pending = 0;
+        for (int count : mPending)
+            pending += static_cast<size_t>(count);
+        return pending;
+    }
+}
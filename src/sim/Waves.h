@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Spawning of the targets by waves over time
+ * \author Maksimovskiy A.S.
+ */
+
+#include <vector>
+
+#include "Targets.h"
+
+namespace sim
+{
+    // Kind of the targets and their count in one wave
+    struct WaveGroup
+    {
+        TargetDesc mDesc;
+        int mCount;
+    };
+
+    // Plan of the waves of the round
+    struct WavePlan
+    {
+        // Targets of each wave
+        std::vector<WaveGroup> mGroups;
+
+        // Area of the initial position of the targets
+        Bounds mRegion;
+
+        // Time between the starts of the waves in seconds. The first wave starts at once.
+        float mInterval;
+
+        // Count of the waves, 0 for the endless mode
+        int mWaveCount;
+
+        // Maximum count of the targets spawned by one step
+        int mSpawnBudget;
+
+        // Maximum count of the live targets. The targets of the started waves wait while it is reached.
+        // In the endless mode it also limits the count of the waiting targets of all groups.
+        int mMaxAlive;
+    };
+
+    // Scheduler of the waves. It only counts the targets to spawn, the world spawns them.
+    // The targets of the started waves are queued and spawned by the budget of one step,
+    // so a large wave is spread over several steps instead of one long step.
+    class WaveSpawner
+    {
+    public:
+        WaveSpawner();
+
+        // Start of the waves of the plan from the first one
+        void Start(const WavePlan& plan);
+
+        // Removing the plan and the queued targets
+        void Stop();
+
+        // Count of the targets of each group of the plan to spawn at the step of dt seconds,
+        // if alive targets are in the world now
+        const TrackedVector<int, MemTag::WAVES>& Tick(float dt, size_t alive);
+
+        // All waves are started and all their targets are spawned. It is never so in the endless mode.
+        bool Done() const;
+
+        bool IsEndless() const { return mActive && mPlan.mWaveCount == 0; }
+
+        // Count of the started waves
+        int Wave() const { return mWave; }
+
+        // Count of the targets waiting for their spawn
+        size_t Pending() const;
+
+        const WavePlan& Plan() const { return mPlan; }
+    private:
+        bool HasWaves() const { return mPlan.mWaveCount == 0 || mWave < mPlan.mWaveCount; }
+
+        WavePlan mPlan;
+        bool mActive;
+
+        // Count of the started waves and the time since the start of the last one
+        int mWave;
+        float mTime;
+
+        // Queued targets of each group
+        TrackedVector<int, MemTag::WAVES> mPending;
+
+        // Result of the last step
+        TrackedVector<int, MemTag::WAVES> mSpawn;
+    };
+}
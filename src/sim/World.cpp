@@ -0,0 +1,227 @@
+/**
+ * \file
+ * \brief Implementation of the battlefield simulation
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+
+#include "Profiler.h"
+#include "World.h"
+
+namespace sim
+{
+    World::World(uint32_t seed) :
+        mBounds{ 0.0f, 0.0f, 0.0f, 0.0f },
+        mSeed(seed),
+        mRandom(seed),
+        mNextBulletId(1),
+        mLastBulletId(0),
+        mRecorder(nullptr)
+    {
+    }
+
+    void World::SetThreadCount(size_t count)
+    {
+        if (count == ThreadCount())
+            return;
+
+        // The parallel solver rounds differently from the serial one, so the replay uses the same count
+        if (mRecorder)
+            mRecorder->ThreadCount(count);
+
+        mTargets.SetThreadPool(nullptr);
+        mPool.reset(count > 1 ? new ThreadPool(count) : nullptr);
+        mTargets.SetThreadPool(mPool.get());
+    }
+
+    void World::SetTickRate(int tick_rate, int max_steps)
+    {
+        if (mRecorder)
+            mRecorder->TickRate(tick_rate, max_steps);
+
+        mClock.SetTickRate(tick_rate);
+        mClock.SetMaxSteps(max_steps);
+    }
+
+    void World::Init(const Bounds& bounds)
+    {
+        if (mRecorder)
+            mRecorder->Init(bounds);
+
+        Clear();
+        mBounds = bounds;
+    }
+
+    void World::SpawnTargets(const TargetDesc& desc, int count, const Bounds& region)
+    {
+        if (mRecorder)
+            mRecorder->Spawn(desc, count, region);
+
+        Spawn(desc, count, region);
+    }
+
+    void World::StartWaves(const WavePlan& plan)
+    {
+        if (mRecorder)
+            mRecorder->Waves(plan);
+
+        mWaves.Start(plan);
+        mTargets.Reserve(static_cast<size_t>(std::max(plan.mMaxAlive, 0)));
+    }
+
+    void World::Spawn(const TargetDesc& desc, int count, const Bounds& region)
+    {
+        if (count <= 0)
+            return;
+
+        // All values of one kind are generated by arrays, so many targets are spawned at once
+        size_t size = static_cast<size_t>(count);
+        mSpawnX.resize(size);
+        mSpawnY.resize(size);
+        mSpawnVx.resize(size);
+        mSpawnVy.resize(size);
+        mSpawnSign.resize(size);
+
+        if (size < 2 * SPAWN_CHUNK)
+            FillSpawn(mRandom, desc, region, 0, size);
+        else
+        {
+            // A large spawn is split into chunks, each of them is generated by its own stream of one seed.
+            // The chunks don't depend on the count of the threads, so the targets are the same with any count.
+            Random batch(mRandom.Next());
+            size_t chunks = (size + SPAWN_CHUNK - 1) / SPAWN_CHUNK;
+            auto fill = [&](size_t begin, size_t end)
+            {
+                for (size_t chunk = begin; chunk < end; chunk++)
+                {
+                    Random random = batch.Stream(static_cast<uint32_t>(chunk));
+                    size_t first = chunk * SPAWN_CHUNK;
+                    FillSpawn(random, desc, region, first, std::min(SPAWN_CHUNK, size - first));
+                }
+            };
+
+            if (mPool)
+                mPool->ParallelFor(chunks, fill);
+            else
+                fill(0, chunks);
+        }
+
+        mTargets.Spawn(desc, mSpawnX.data(), mSpawnY.data(), mSpawnVx.data(), mSpawnVy.data(), size);
+    }
+
+    uint32_t World::Fire(const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert)
+    {
+        uint32_t id = ReserveBulletId();
+        Fire(id, desc, point, rotate_angle, invert);
+        return id;
+    }
+
+    void World::Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert)
+    {
+        if (mRecorder)
+            mRecorder->Fire(id, desc, point, rotate_angle, invert);
+
+        mBullets.Fire(id, desc, point, rotate_angle, invert);
+        mLastBulletId = id;
+    }
+
+    void World::Step(float dt)
+    {
+        if (mRecorder)
+            mRecorder->Step(dt);
+
+        mRetiredBullets.clear();
+        Tick(dt);
+    }
+
+    int World::Update(float dt)
+    {
+        if (mRecorder)
+            mRecorder->Update(dt);
+
+        // The bullets of all steps are kept until the next update, so the presenter sees each removed bullet
+        mRetiredBullets.clear();
+
+        int steps = mClock.Advance(dt);
+        for (int i = 0; i < steps; i++)
+            Tick(mClock.Step());
+
+        // Each step adds its bullets in the order of the identifiers, the bullets of several steps are ordered again
+        if (steps > 1)
+        {
+            std::sort(mRetiredBullets.begin(), mRetiredBullets.end(), [](const Bullet& a, const Bullet& b)
+            {
+                return a.mId < b.mId;
+            });
+        }
+        return steps;
+    }
+
+    void World::FillSpawn(Random& random, const TargetDesc& desc, const Bounds& region, size_t first, size_t count)
+    {
+        // Setting the initial position of the target
+        random.FillPoints(mSpawnX.data() + first, mSpawnY.data() + first, count, region);
+
+        // Generating the original target velocity. Both projections have the same sign.
+        random.FillReal(mSpawnVx.data() + first, count, desc.mMinSpeed, desc.mMaxSpeed);
+        random.FillReal(mSpawnVy.data() + first, count, desc.mMinSpeed, desc.mMaxSpeed);
+        random.FillSigns(mSpawnSign.data() + first, count);
+        for (size_t i = first; i < first + count; i++)
+        {
+            mSpawnVx[i] *= mSpawnSign[i];
+            mSpawnVy[i] *= mSpawnSign[i];
+        }
+    }
+
+    void World::Tick(float dt)
+    {
+        PROFILE_ZONE("Tick");
+        float target_dt = dt * TARGET_TIME_SCALE;
+        mTargets.CalcInteractions(target_dt);
+        mTargets.Move(target_dt, mBounds);
+
+        mBullets.Move(dt * BULLET_TIME_SCALE, mTargets);
+        mBullets.DeleteUsed(mRetiredBullets);
+
+        mTargets.DeleteDead();
+
+        // New targets take the places of the dead ones
+        PROFILE_ZONE("SpawnWaves");
+        auto& spawn = mWaves.Tick(dt, mTargets.Size());
+        for (size_t i = 0; i < spawn.size(); i++)
+            Spawn(mWaves.Plan().mGroups[i].mDesc, spawn[i], mWaves.Plan().mRegion);
+    }
+
+    void World::Clear()
+    {
+        mTargets.Clear();
+        mWaves.Stop();
+        mBullets.Clear();
+        mRetiredBullets.clear();
+        mClock.Reset();
+    }
+
+    void World::ClearTargets()
+    {
+        if (mRecorder)
+            mRecorder->ClearTargets();
+
+        mTargets.Clear();
+        mWaves.Stop();
+    }
+
+    void World::ClearBullets()
+    {
+        if (mRecorder)
+            mRecorder->ClearBullets();
+
+        mBullets.Clear();
+    }
+
+    void World::ReserveBullets(size_t count)
+    {
+        mBullets.Reserve(count);
+        mRetiredBullets.reserve(count);
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Headless simulation of the battlefield
+ * \author Maksimovskiy A.S.
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Bullets.h"
+#include "Random.h"
+#include "Recording.h"
+#include "StepClock.h"
+#include "Targets.h"
+#include "ThreadPool.h"
+#include "Waves.h"
+
+namespace sim
+{
+    // Time scale of the movement of the targets relative to real time
+    const float TARGET_TIME_SCALE = 2.0f;
+    // Time scale of the flight of the bullets relative to real time
+    const float BULLET_TIME_SCALE = 10.0f;
+    // Count of the targets generated by one stream of the random numbers in a large spawn
+    const size_t SPAWN_CHUNK = 4096;
+
+    // Class owning the state of all targets and bullets.
+    // It doesn't depend on the engine and is advanced by an explicit time step.
+    class World
+    {
+    public:
+        explicit World(uint32_t seed = 0);
+
+        // Seed of the random numbers of the world
+        uint32_t Seed() const { return mSeed; }
+
+        // Method for initial setting of the limits of movement of the targets
+        void Init(const Bounds& bounds);
+
+        // Adding targets of one kind at random positions inside the region
+        void SpawnTargets(const TargetDesc& desc, int count, const Bounds& region);
+
+        // Start of the waves of the targets. The targets are spawned at the end of the steps by the plan.
+        // The memory of the targets is reserved for the limit of the live targets at once.
+        void StartWaves(const WavePlan& plan);
+
+        // Shot of a new bullet. Returns the bullet identifier.
+        uint32_t Fire(const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert);
+
+        // Shot of a new bullet with the identifier reserved before
+        void Fire(uint32_t id, const BulletDesc& desc, const Vec2& point, float rotate_angle, bool invert);
+
+        // Identifier for the next shot. Can be called from any thread.
+        uint32_t ReserveBulletId() { return mNextBulletId++; }
+
+        // Identifier of the last bullet added to the world
+        uint32_t LastBulletId() const { return mLastBulletId; }
+
+        // Advancing the simulation by dt seconds of real time in one step
+        void Step(float dt);
+
+        // Advancing the simulation by the fixed steps of the clock for dt seconds of real time.
+        // Returns the count of the steps made.
+        int Update(float dt);
+
+        // Share of the next fixed step covered by the time of the updates.
+        // The objects are drawn at this share between their previous and current positions.
+        float Alpha() const { return mClock.Alpha(); }
+
+        // Setting the count of the fixed steps per second and the maximum count of the steps per update
+        void SetTickRate(int tick_rate, int max_steps);
+
+        // Count of the threads for the interaction of many targets, including the calling one. 1 by default.
+        void SetThreadCount(size_t count);
+        size_t ThreadCount() const { return mPool ? mPool->Size() : 1; }
+
+        // Removing all targets and bullets and stopping the waves
+        void Clear();
+
+        // Removing all targets and stopping the waves
+        void ClearTargets();
+
+        void ClearBullets();
+
+        // Reserving the memory for count bullets in flight and as many retired ones
+        void ReserveBullets(size_t count);
+
+        // Log for all changes of the world, may be null
+        void SetRecorder(Recorder* recorder) { mRecorder = recorder; }
+
+        TargetSystem& Targets() { return mTargets; }
+        const TargetSystem& Targets() const { return mTargets; }
+
+        BulletSystem& Bullets() { return mBullets; }
+        const BulletSystem& Bullets() const { return mBullets; }
+
+        // Bullets removed during the last step or the last update in the order of their identifiers
+        const BulletArray<Bullet>& RetiredBullets() const { return mRetiredBullets; }
+
+        const WaveSpawner& Waves() const { return mWaves; }
+
+        const Bounds& GetBounds() const { return mBounds; }
+
+        Random& GetRandom() { return mRandom; }
+    private:
+        // One step of the simulation. The removed bullets are added to the retired ones.
+        void Tick(float dt);
+
+        // Adding the targets without recording, the recorded changes spawn them by themselves on the replay
+        void Spawn(const TargetDesc& desc, int count, const Bounds& region);
+
+        // Generating the positions and velocities of the spawned targets from first to first + count
+        void FillSpawn(Random& random, const TargetDesc& desc, const Bounds& region, size_t first, size_t count);
+
+        TargetSystem mTargets;
+        BulletSystem mBullets;
+        BulletArray<Bullet> mRetiredBullets;
+
+        // Limits of movement of the targets
+        Bounds mBounds;
+
+        uint32_t mSeed;
+        Random mRandom;
+
+        // Positions, velocities and their signs of the spawned targets
+        TargetArray<float> mSpawnX;
+        TargetArray<float> mSpawnY;
+        TargetArray<float> mSpawnVx;
+        TargetArray<float> mSpawnVy;
+        TargetArray<float> mSpawnSign;
+
+        WaveSpawner mWaves;
+
+        StepClock mClock;
+
+        // Threads for the interaction of the targets, null for one thread
+        std::unique_ptr<ThreadPool> mPool;
+
+        // Identifier of the next shot
+        std::atomic<uint32_t> mNextBulletId;
+        uint32_t mLastBulletId;
+
+        Recorder* mRecorder;
+    };
+}
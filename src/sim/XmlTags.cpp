@@ -0,0 +1,218 @@
+/**
+ * \file
+ * \brief Implementation of the scanning of the XML tags
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "XmlTags.h"
+
+namespace sim
+{
+    namespace
+    {
+        using Attributes = std::vector<std::pair<std::string, std::string>>;
+
+        bool IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        bool IsNameChar(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                   c == '_' || c == '-' || c == ':' || c == '.';
+        }
+
+        size_t SkipSpaces(const std::string& xml, size_t pos)
+        {
+            while (pos < xml.size() && IsSpace(xml[pos]))
+                pos++;
+            return pos;
+        }
+
+        size_t SkipName(const std::string& xml, size_t pos)
+        {
+            while (pos < xml.size() && IsNameChar(xml[pos]))
+                pos++;
+            return pos;
+        }
+
+        // Position after the comment, the declaration or the instruction at pos, pos if there is none of them
+        // and npos if it isn't closed
+        size_t SkipMarkup(const std::string& xml, size_t pos)
+        {
+            size_t end = pos;
+            if (xml.compare(pos, 4, "<!--") == 0)
+            {
+                end = xml.find("-->", pos + 4);
+                return end == std::string::npos ? end : end + 3;
+            }
+            if (xml.compare(pos, 2, "<?") == 0)
+            {
+                end = xml.find("?>", pos + 2);
+                return end == std::string::npos ? end : end + 2;
+            }
+            if (xml.compare(pos, 2, "<!") == 0)
+            {
+                end = xml.find('>', pos + 2);
+                return end == std::string::npos ? end : end + 1;
+            }
+            return pos;
+        }
+
+        // Reading the attributes of the tag starting at pos. Returns the position of its closing bracket
+        // or npos if the tag is wrong. The end of the text closes the tag, so a tag cut before its bracket is read too.
+        size_t ReadTag(const std::string& xml, size_t pos, Attributes* attributes)
+        {
+            pos = SkipName(xml, pos + 1);
+            while (true)
+            {
+                size_t next = SkipSpaces(xml, pos);
+                if (next >= xml.size())
+                    return xml.size();
+                if (xml[next] == '>')
+                    return next;
+                if (xml[next] == '/')
+                    return next + 1 < xml.size() && xml[next + 1] != '>' ? std::string::npos : next + 1;
+
+                // The attributes are separated by whitespace
+                if (next == pos)
+                    return std::string::npos;
+
+                size_t name_end = SkipName(xml, next);
+                if (name_end == next)
+                    return std::string::npos;
+
+                size_t value = SkipSpaces(xml, name_end);
+                if (value >= xml.size() || xml[value] != '=')
+                    return std::string::npos;
+
+                value = SkipSpaces(xml, value + 1);
+                if (value >= xml.size() || (xml[value] != '"' && xml[value] != '\''))
+                    return std::string::npos;
+
+                size_t value_end = xml.find(xml[value], value + 1);
+                if (value_end == std::string::npos)
+                    return std::string::npos;
+
+                if (attributes)
+                {
+                    attributes->emplace_back(xml.substr(next, name_end - next),
+                                             xml.substr(value + 1, value_end - value - 1));
+                }
+                pos = value_end + 1;
+            }
+        }
+
+        std::string LineError(const std::string& xml, size_t pos, const std::string& text)
+        {
+            size_t line = static_cast<size_t>(std::count(xml.begin(), xml.begin() + pos, '\n')) + 1;
+            return "line " + std::to_string(line) + ": " + text;
+        }
+
+        // Tags with the name as the pairs of their beginning and their closing bracket
+        std::vector<std::pair<size_t, size_t>> ScanTags(const std::string& xml, const std::string& name,
+                                                        std::vector<std::string>& errors)
+        {
+            std::vector<std::pair<size_t, size_t>> tags;
+            size_t pos = 0;
+            while ((pos = xml.find('<', pos)) != std::string::npos)
+            {
+                size_t skipped = SkipMarkup(xml, pos);
+                if (skipped == std::string::npos)
+                {
+                    errors.push_back(LineError(xml, pos, "comment or declaration isn't closed"));
+                    break;
+                }
+                if (skipped != pos)
+                {
+                    pos = skipped;
+                    continue;
+                }
+
+                size_t name_end = SkipName(xml, pos + 1);
+                if (xml.compare(pos + 1, name_end - pos - 1, name) != 0)
+                {
+                    pos = name_end;
+                    continue;
+                }
+
+                size_t end = ReadTag(xml, pos, nullptr);
+                if (end == std::string::npos || end == xml.size())
+                {
+                    errors.push_back(LineError(xml, pos, "can't read the tag <" + name));
+                    pos = name_end;
+                    continue;
+                }
+
+                tags.emplace_back(pos, end);
+                pos = end;
+            }
+            return tags;
+        }
+
+        Attributes ReadAttributes(const std::string& tag)
+        {
+            Attributes attributes;
+            if (!tag.empty() && tag[0] == '<')
+                ReadTag(tag, 0, &attributes);
+            return attributes;
+        }
+    }
+
+    std::vector<std::string> FindTags(const std::string& xml, const std::string& name, std::vector<std::string>& errors)
+    {
+        std::vector<std::string> tags;
+        for (auto& tag : ScanTags(xml, name, errors))
+            tags.push_back(xml.substr(tag.first, tag.second - tag.first));
+        return tags;
+    }
+
+    std::vector<std::string> FindElements(const std::string& xml, const std::string& name, std::vector<std::string>& errors)
+    {
+        std::vector<std::string> elements;
+        const std::string closing = "</" + name;
+        for (auto& tag : ScanTags(xml, name, errors))
+        {
+            if (xml[tag.second - 1] == '/')
+            {
+                elements.push_back(xml.substr(tag.first, tag.second - tag.first));
+                continue;
+            }
+
+            // The closing tag of a longer name is skipped
+            size_t end = tag.second;
+            while ((end = xml.find(closing, end)) != std::string::npos && end + closing.size() < xml.size() &&
+                   IsNameChar(xml[end + closing.size()]))
+                end += closing.size();
+            if (end == std::string::npos)
+            {
+                errors.push_back(LineError(xml, tag.first, "<" + name + "> isn't closed"));
+                continue;
+            }
+            elements.push_back(xml.substr(tag.first, end - tag.first));
+        }
+        return elements;
+    }
+
+    std::string TagAttribute(const std::string& tag, const std::string& name)
+    {
+        for (auto& attribute : ReadAttributes(tag))
+        {
+            if (attribute.first == name)
+                return attribute.second;
+        }
+        return std::string();
+    }
+
+    std::vector<std::string> TagAttributeNames(const std::string& tag)
+    {
+        std::vector<std::string> names;
+        for (auto& attribute : ReadAttributes(tag))
+            names.push_back(attribute.first);
+        return names;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Scanning of the tags of simple XML files
+ * \author Maksimovskiy A.S.
+ */
+
+#include <string>
+#include <vector>
+
+namespace sim
+{
+    // Text of all tags with the name, from the name to the closing bracket.
+    // The resource files only describe objects by the attributes of single tags,
+    // so they are scanned without a full XML parser. The comments are skipped, the names and attributes
+    // may be separated by any whitespace. A tag with the name whose attributes can't be read is added to errors.
+    std::vector<std::string> FindTags(const std::string& xml, const std::string& name, std::vector<std::string>& errors);
+
+    // Text of all elements with the name, from their tag to their closing tag.
+    // A self-closing tag is an element without content.
+    std::vector<std::string> FindElements(const std::string& xml, const std::string& name, std::vector<std::string>& errors);
+
+    // Value of the attribute of the first tag of the text or an empty string
+    std::string TagAttribute(const std::string& tag, const std::string& name);
+
+    // Names of all attributes of the first tag of the text
+    std::vector<std::string> TagAttributeNames(const std::string& tag);
+}
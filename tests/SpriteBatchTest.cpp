@@ -0,0 +1,152 @@
+/**
+ * \file
+ * \brief Checks of the vertices built by sim::SpriteBatch
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "sim/Memory.h"
+#include "sim/SpriteBatch.h"
+
+namespace
+{
+    // Difference of the vertices allowed for the rounding of the table sine
+    const float TOLERANCE = 1e-3f;
+
+    int failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+
+    bool Near(float a, float b)
+    {
+        return std::fabs(a - b) <= TOLERANCE;
+    }
+
+    bool VertexIs(const sim::SpriteVertex& vertex, float x, float y, float u, float v)
+    {
+        return Near(vertex.x, x) && Near(vertex.y, y) && Near(vertex.u, u) && Near(vertex.v, v);
+    }
+
+    // Images and textures of the engine are only identified by their addresses
+    int ATLAS;
+    int SEPARATE;
+    int BOMB;
+    int BULLET;
+    int AIM;
+
+    void CheckQuad()
+    {
+        sim::SpriteBatch batch;
+        sim::UvRect full{ 0.0f, 0.0f, 1.0f, 1.0f };
+        size_t frame = batch.Frame(&AIM, &SEPARATE, 20.0f, 10.0f, full);
+        batch.Add(frame, 5.0f, 7.0f);
+
+        auto& vertices = batch.Groups()[0].mVertices;
+        Check(vertices.size() == 4, "a sprite has four corners");
+        Check(VertexIs(vertices[0], 5.0f, 7.0f, 0.0f, 0.0f), "corner (0, 0) of the quad");
+        Check(VertexIs(vertices[1], 25.0f, 7.0f, 1.0f, 0.0f), "corner (width, 0) of the quad");
+        Check(VertexIs(vertices[2], 5.0f, 17.0f, 0.0f, 1.0f), "corner (0, height) of the quad");
+        Check(VertexIs(vertices[3], 25.0f, 17.0f, 1.0f, 1.0f), "corner (width, height) of the quad");
+    }
+
+    void CheckRotation()
+    {
+        // The image turns counterclockwise around its corner at the point
+        sim::SpriteBatch batch;
+        sim::UvRect full{ 0.0f, 0.0f, 1.0f, 1.0f };
+        size_t frame = batch.Frame(&AIM, &SEPARATE, 20.0f, 10.0f, full);
+        batch.Add(frame, 100.0f, 50.0f, 90.0f);
+
+        auto& vertices = batch.Groups()[0].mVertices;
+        Check(VertexIs(vertices[0], 100.0f, 50.0f, 0.0f, 0.0f), "the corner at the point doesn't move");
+        Check(VertexIs(vertices[1], 100.0f, 70.0f, 1.0f, 0.0f), "the width side turns by 90 degrees");
+        Check(VertexIs(vertices[2], 90.0f, 50.0f, 0.0f, 1.0f), "the height side turns by 90 degrees");
+        Check(VertexIs(vertices[3], 90.0f, 70.0f, 1.0f, 1.0f), "the far corner turns by 90 degrees");
+
+        batch.Clear();
+        batch.Add(frame, 0.0f, 0.0f, 30.0f);
+        float c = std::cos(30.0f * 3.14159265f / 180.0f);
+        float s = std::sin(30.0f * 3.14159265f / 180.0f);
+        Check(VertexIs(vertices[1], 20.0f * c, 20.0f * s, 1.0f, 0.0f), "the width side turns by 30 degrees");
+        Check(VertexIs(vertices[2], -10.0f * s, 10.0f * c, 0.0f, 1.0f), "the height side turns by 30 degrees");
+    }
+
+    void CheckGroups()
+    {
+        // Two images of the atlas share its group, the separate image has its own one
+        sim::SpriteBatch batch;
+        size_t bomb = batch.Frame(&BOMB, &ATLAS, 32.0f, 32.0f, sim::UvRect{ 0.0f, 0.0f, 0.125f, 0.125f });
+        size_t bullet = batch.Frame(&BULLET, &ATLAS, 8.0f, 16.0f, sim::UvRect{ 0.5f, 0.25f, 0.53125f, 0.3125f });
+        size_t aim = batch.Frame(&AIM, &SEPARATE, 16.0f, 16.0f, sim::UvRect{ 0.0f, 0.0f, 1.0f, 1.0f });
+        Check(batch.Frame(&BOMB, &ATLAS, 32.0f, 32.0f, sim::UvRect{ 0.0f, 0.0f, 0.125f, 0.125f }) == bomb,
+              "the frame of an image is added once");
+        Check(batch.FindFrame(&BULLET) == bullet, "the frame is found by its image");
+        Check(batch.Groups().size() == 2, "one group per texture");
+        Check(batch.Frames()[bomb].mGroup == batch.Frames()[bullet].mGroup, "the images of the atlas share the group");
+        Check(batch.Frames()[aim].mGroup != batch.Frames()[bomb].mGroup, "the separate image has its own group");
+
+        batch.Add(bomb, 0.0f, 0.0f);
+        batch.Add(bullet, 10.0f, 20.0f);
+        batch.Add(bomb, 50.0f, 0.0f);
+
+        auto& atlas = batch.Groups()[batch.Frames()[bomb].mGroup].mVertices;
+        Check(atlas.size() == 12, "the sprites of the atlas are in its group");
+        Check(VertexIs(atlas[4], 10.0f, 20.0f, 0.5f, 0.25f), "the UV of the atlas region at (0, 0)");
+        Check(VertexIs(atlas[7], 18.0f, 36.0f, 0.53125f, 0.3125f), "the UV of the atlas region at (width, height)");
+
+        sim::BatchStats stats = batch.Stats();
+        Check(stats.mSprites == 3 && stats.mBatches == 1 && stats.mVertices == 12,
+              "only the groups with sprites need a draw call");
+    }
+
+    void CheckCapacity()
+    {
+        sim::SpriteBatch batch;
+        size_t frame = batch.Frame(&BOMB, &ATLAS, 32.0f, 32.0f, sim::UvRect{ 0.0f, 0.0f, 1.0f, 1.0f });
+        for (int i = 0; i < 1000; i++)
+            batch.Add(frame, static_cast<float>(i), 0.0f);
+
+        auto& vertices = batch.Groups()[0].mVertices;
+        Check(vertices.size() == 4000, "the group grows with the sprites");
+        size_t capacity = vertices.capacity();
+
+        // The next frame with as many sprites reuses the memory of the previous one
+        auto& memory = sim::MemoryTracker::Instance();
+        uint64_t allocs = memory.Stats(sim::MemTag::SPRITES).mAllocs;
+        batch.Clear();
+        Check(vertices.empty() && vertices.capacity() == capacity, "clearing keeps the memory");
+        for (int i = 0; i < 1000; i++)
+            batch.Add(frame, static_cast<float>(i), 0.0f);
+        Check(memory.Stats(sim::MemTag::SPRITES).mAllocs == allocs, "the same count of sprites doesn't allocate");
+
+        for (int i = 0; i < 1000; i++)
+            batch.Add(frame, static_cast<float>(i), 0.0f);
+        Check(vertices.size() == 8000 && vertices.capacity() >= 8000, "more sprites grow the group");
+    }
+}
+
+int main()
+{
+    CheckQuad();
+    CheckRotation();
+    CheckGroups();
+    CheckCapacity();
+
+    if (failures > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    std::printf("SpriteBatch: all checks passed\n");
+    return 0;
+}
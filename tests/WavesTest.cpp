@@ -0,0 +1,100 @@
+/**
+ * \file
+ * \brief Checks of the targets counted by sim::WaveSpawner
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "sim/Waves.h"
+
+namespace
+{
+    // Step of the game at 60 FPS
+    const float DT = 1.0f / 60.0f;
+
+    int failures = 0;
+
+    void Check(bool condition, const char* what)
+    {
+        if (condition)
+            return;
+
+        std::fprintf(stderr, "FAIL: %s\n", what);
+        failures++;
+    }
+
+    // Plan of two groups with more targets in a wave than the limit of the live ones
+    sim::WavePlan MakePlan(int wave_count)
+    {
+        sim::TargetDesc desc{ 0, sim::Movement::LINEAR, 10.0f, 0.0f, 0.0f, 1, 10.0f, 20.0f };
+        sim::WavePlan plan;
+        plan.mGroups = { sim::WaveGroup{ desc, 30 }, sim::WaveGroup{ desc, 20 } };
+        plan.mRegion = sim::Bounds{ 0.0f, 100.0f, 0.0f, 100.0f };
+        plan.mInterval = 1.0f;
+        plan.mWaveCount = wave_count;
+        plan.mSpawnBudget = 10;
+        plan.mMaxAlive = 25;
+        return plan;
+    }
+
+    void CheckFiniteWaves()
+    {
+        sim::WaveSpawner spawner;
+        spawner.Start(MakePlan(3));
+
+        // A few live targets are killed on each step, so the limit is reached and freed again
+        int spawned[2] = { 0, 0 };
+        size_t alive = 0;
+        size_t max_alive = 0;
+        for (int step = 0; step < 100000 && !spawner.Done(); step++)
+        {
+            auto& spawn = spawner.Tick(DT, alive);
+            for (size_t i = 0; i < spawn.size(); i++)
+            {
+                spawned[i] += spawn[i];
+                alive += static_cast<size_t>(spawn[i]);
+            }
+            max_alive = std::max(max_alive, alive);
+            alive -= std::min<size_t>(alive, 3);
+        }
+
+        Check(max_alive <= 25, "the live targets don't exceed the limit");
+        Check(spawner.Done(), "the finite waves end");
+        Check(spawned[0] == 90, "all targets of the first group are spawned");
+        Check(spawned[1] == 60, "all targets of the second group are spawned");
+    }
+
+    void CheckEndlessQueue()
+    {
+        sim::WaveSpawner spawner;
+        spawner.Start(MakePlan(0));
+
+        // The limit of the live targets is reached, so nothing is spawned and the waves are missed
+        size_t max_pending = 0;
+        for (int step = 0; step < 60 * 10; step++)
+        {
+            spawner.Tick(DT, 25);
+            max_pending = std::max(max_pending, spawner.Pending());
+        }
+        Check(max_pending <= 25, "the queue of all groups doesn't exceed the limit");
+        Check(spawner.Pending() == 25, "the queue of the endless waves is full");
+        Check(!spawner.Done(), "the endless waves don't end");
+    }
+}
+
+int main()
+{
+    CheckFiniteWaves();
+    CheckEndlessQueue();
+
+    if (failures > 0)
+    {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    std::printf("WaveSpawner: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * \file
+ * \brief Packing of the small textures of Resources.xml into one atlas
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <png.h>
+
+#include "sim/Atlas.h"
+#include "sim/XmlTags.h"
+
+namespace
+{
+    // Images larger than this on any side (backgrounds) stay separate textures
+    const int DEFAULT_MAX_IMAGE = 256;
+    // Maximum side of the atlas
+    const int DEFAULT_MAX_SIZE = 2048;
+    // Pixels around each image filled by its border, so the neighbours don't bleed in on filtering
+    const int DEFAULT_PADDING = 2;
+    // Path of the atlas relative to the resources folder without the extension
+    const char* ATLAS_PATH = "textures/atlas";
+
+    // Image in RGBA, 4 bytes per pixel, rows from the top
+    struct Image
+    {
+        int mWidth;
+        int mHeight;
+        std::vector<uint8_t> mPixels;
+    };
+
+    // Texture from Resources.xml
+    struct TextureEntry
+    {
+        std::string mId;
+        std::string mPath;
+    };
+
+    bool ReadFile(const std::string& path, std::string& text)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        text = buffer.str();
+        return true;
+    }
+
+    // All textures of Resources.xml. The tags which can't be read are added to errors.
+    std::vector<TextureEntry> ReadTextures(const std::string& xml, std::vector<std::string>& errors)
+    {
+        std::vector<TextureEntry> textures;
+        for (auto& tag : sim::FindTags(xml, "texture", errors))
+        {
+            TextureEntry entry{ sim::TagAttribute(tag, "id"), sim::TagAttribute(tag, "path") };
+            if (!entry.mId.empty() && !entry.mPath.empty())
+                textures.push_back(entry);
+        }
+        return textures;
+    }
+
+    bool LoadPng(const std::string& path, Image& image)
+    {
+        png_image png;
+        std::memset(&png, 0, sizeof(png));
+        png.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_file(&png, path.c_str()))
+            return false;
+
+        png.format = PNG_FORMAT_RGBA;
+        image.mWidth = static_cast<int>(png.width);
+        image.mHeight = static_cast<int>(png.height);
+        image.mPixels.resize(PNG_IMAGE_SIZE(png));
+        if (!png_image_finish_read(&png, nullptr, image.mPixels.data(), 0, nullptr))
+        {
+            png_image_free(&png);
+            return false;
+        }
+        return true;
+    }
+
+    bool SavePng(const std::string& path, const Image& image)
+    {
+        png_image png;
+        std::memset(&png, 0, sizeof(png));
+        png.version = PNG_IMAGE_VERSION;
+        png.width = static_cast<png_uint_32>(image.mWidth);
+        png.height = static_cast<png_uint_32>(image.mHeight);
+        png.format = PNG_FORMAT_RGBA;
+        return png_image_write_to_file(&png, path.c_str(), 0, image.mPixels.data(), 0, nullptr) != 0;
+    }
+
+    // Copying the image to the region of the atlas. The padding is filled by the nearest border pixels of the image.
+    void Blit(const Image& image, const sim::AtlasRegion& region, int padding, Image& atlas)
+    {
+        for (int y = -padding; y < image.mHeight + padding; y++)
+        {
+            int src_y = std::min(std::max(y, 0), image.mHeight - 1);
+            for (int x = -padding; x < image.mWidth + padding; x++)
+            {
+                int src_x = std::min(std::max(x, 0), image.mWidth - 1);
+                const uint8_t* src = &image.mPixels[(static_cast<size_t>(src_y) * image.mWidth + src_x) * 4];
+                uint8_t* dst = &atlas.mPixels[(static_cast<size_t>(region.mY + y) * atlas.mWidth + region.mX + x) * 4];
+                std::memcpy(dst, src, 4);
+            }
+        }
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "Usage: war_atlas <resources folder> [--max-image N] [--max-size N] [--padding N]\n"
+            "Packs the textures of <resources folder>/Resources.xml not larger than --max-image (%d) pixels\n"
+            "into %s.png and writes the places of the images to %s.txt.\n",
+            DEFAULT_MAX_IMAGE, ATLAS_PATH, ATLAS_PATH);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::string folder = argv[1];
+    int max_image = DEFAULT_MAX_IMAGE;
+    int max_size = DEFAULT_MAX_SIZE;
+    int padding = DEFAULT_PADDING;
+    for (int i = 2; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 2;
+        }
+
+        int value = std::atoi(argv[++i]);
+        if (arg == "--max-image")
+            max_image = value;
+        else if (arg == "--max-size")
+            max_size = value;
+        else if (arg == "--padding")
+            padding = value;
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    std::string xml;
+    if (!ReadFile(folder + "/Resources.xml", xml))
+    {
+        std::fprintf(stderr, "Can't read %s/Resources.xml\n", folder.c_str());
+        return 1;
+    }
+
+    std::vector<std::string> errors;
+    auto textures = ReadTextures(xml, errors);
+    for (auto& error : errors)
+        std::fprintf(stderr, "Resources.xml: %s\n", error.c_str());
+    if (!errors.empty())
+        return 1;
+
+    sim::AtlasTable table{ ATLAS_PATH, 0, 0, {} };
+    std::vector<Image> images;
+    for (auto& texture : textures)
+    {
+        // The atlas itself isn't packed again
+        if (texture.mPath == ATLAS_PATH)
+            continue;
+
+        Image image;
+        std::string path = folder + "/" + texture.mPath + ".png";
+        if (!LoadPng(path, image))
+        {
+            std::fprintf(stderr, "Can't read %s\n", path.c_str());
+            return 1;
+        }
+
+        if (image.mWidth > max_image || image.mHeight > max_image)
+        {
+            std::printf("skipped %s: %dx%d\n", texture.mId.c_str(), image.mWidth, image.mHeight);
+            continue;
+        }
+
+        table.mRegions.push_back(sim::AtlasRegion{ texture.mId, 0, 0, image.mWidth, image.mHeight });
+        images.push_back(std::move(image));
+    }
+
+    if (!sim::PackAtlas(table, max_size, padding))
+    {
+        std::fprintf(stderr, "The images don't fit into %dx%d\n", max_size, max_size);
+        return 1;
+    }
+
+    Image atlas{ table.mWidth, table.mHeight, {} };
+    atlas.mPixels.assign(static_cast<size_t>(atlas.mWidth) * atlas.mHeight * 4, 0);
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        Blit(images[i], table.mRegions[i], padding, atlas);
+        auto& region = table.mRegions[i];
+        std::printf("packed %s: %dx%d at %d,%d\n", region.mName.c_str(), region.mWidth, region.mHeight, region.mX, region.mY);
+    }
+
+    std::string image_path = folder + "/" + ATLAS_PATH + ".png";
+    if (!SavePng(image_path, atlas))
+    {
+        std::fprintf(stderr, "Can't write %s\n", image_path.c_str());
+        return 1;
+    }
+
+    std::string table_path = folder + "/" + ATLAS_PATH + ".txt";
+    std::ofstream table_file(table_path, std::ios::binary);
+    table_file << sim::FormatAtlasTable(table);
+    if (!table_file)
+    {
+        std::fprintf(stderr, "Can't write %s\n", table_path.c_str());
+        return 1;
+    }
+
+    std::printf("atlas: %dx%d, %zu images\n", table.mWidth, table.mHeight, table.mRegions.size());
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file
+ * \brief Implementation of the benchmarks helpers
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "Bench.h"
+
+namespace bench
+{
+    // Screen area per one target in the game
+    const float AREA_PER_TARGET = 1024.0f * 768.0f / 20.0f;
+
+    namespace
+    {
+        std::vector<Result>& MutableResults()
+        {
+            static std::vector<Result> results;
+            return results;
+        }
+
+        size_t failures = 0;
+    }
+
+    void Report(const std::string& name, size_t size, double seconds)
+    {
+        MutableResults().push_back(Result{ name, size, seconds * 1e9 });
+    }
+
+    const std::vector<Result>& Results()
+    {
+        return MutableResults();
+    }
+
+    bool Check(const std::string& name, size_t size, double value, double tolerance)
+    {
+        if (value <= tolerance)
+            return true;
+
+        std::printf("FAILED %s, size %zu: %.3e exceeds %.3e\n", name.c_str(), size, value, tolerance);
+        failures++;
+        return false;
+    }
+
+    size_t Failures()
+    {
+        return failures;
+    }
+
+    bool WriteResults(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream file(path);
+        file << "name,size,ns\n";
+        for (auto& result : results)
+            file << result.mName << "," << result.mSize << "," << result.mNs << "\n";
+        return static_cast<bool>(file);
+    }
+
+    bool ReadResults(const std::string& path, std::vector<Result>& results)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+
+        // The header and the wrong lines are skipped
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream in(line);
+            Result result;
+            char comma = 0;
+            if (std::getline(in, result.mName, ',') && in >> result.mSize >> comma >> result.mNs && comma == ',')
+                results.push_back(result);
+        }
+        return true;
+    }
+
+    size_t CompareResults(const std::vector<Result>& baseline, double tolerance)
+    {
+        size_t regressions = 0;
+        std::printf("%-28s %10s %14s %14s %8s\n", "name", "size", "baseline, ns", "now, ns", "ratio");
+        for (auto& result : Results())
+        {
+            auto base = std::find_if(baseline.begin(), baseline.end(), [&result](const Result& other)
+            {
+                return other.mName == result.mName && other.mSize == result.mSize;
+            });
+            if (base == baseline.end() || base->mNs <= 0.0)
+                continue;
+
+            double ratio = result.mNs / base->mNs;
+            bool regression = ratio > 1.0 + tolerance;
+            regressions += regression;
+            std::printf("%-28s %10zu %14.1f %14.1f %8.2f%s\n", result.mName.c_str(), result.mSize, base->mNs,
+                        result.mNs, ratio, regression ? "  REGRESSION" : "");
+        }
+        return regressions;
+    }
+
+    sim::TargetDesc BombDesc()
+    {
+        return sim::TargetDesc{ 0, sim::Movement::LINEAR, 45.0f, 32.0f, 32.0f, 20, 10.0f, 30.0f };
+    }
+
+    sim::TargetDesc SuperBombDesc()
+    {
+        return sim::TargetDesc{ 1, sim::Movement::NONLINEAR, 45.0f, 32.0f, 32.0f, 25, 50.0f, 70.0f };
+    }
+
+    void FillWorld(sim::World& world, size_t count)
+    {
+        float side = std::sqrt(AREA_PER_TARGET * static_cast<float>(count) * 4.0f / 3.0f);
+        sim::Bounds bounds{ 0.0f, side, 0.0f, side * 0.75f };
+        world.Init(bounds);
+
+        size_t super_count = std::min<size_t>(count, 10);
+        world.SpawnTargets(SuperBombDesc(), static_cast<int>(super_count), bounds);
+        world.SpawnTargets(BombDesc(), static_cast<int>(count - super_count), bounds);
+    }
+
+    int Repeats(double run_time, double budget)
+    {
+        if (run_time <= 0.0)
+            return 1000;
+
+        return std::max(1, std::min(1000, static_cast<int>(budget / run_time)));
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * \file
+ * \brief Helpers of the simulation benchmarks
+ * \author Maksimovskiy A.S.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "sim/World.h"
+
+namespace bench
+{
+    // Measurement of the elapsed time
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : mStart(std::chrono::steady_clock::now()) {}
+
+        void Restart() { mStart = std::chrono::steady_clock::now(); }
+
+        // Elapsed time in seconds
+        double Seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - mStart).count();
+        }
+    private:
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+    // Measured time of one operation of a benchmark for the size of its input
+    struct Result
+    {
+        // Name of the measured version, e.g. "collisions.grid"
+        std::string mName;
+        size_t mSize;
+        double mNs;
+    };
+
+    // Adding the time of one operation in seconds to the results of the run
+    void Report(const std::string& name, size_t size, double seconds);
+
+    // Results of all benchmarks of the run in the order of the measurements
+    const std::vector<Result>& Results();
+
+    // Check of a result of a version against the reference one. A value above the tolerance is a failure,
+    // it is printed with the name and the size of the input. Returns whether the check has passed.
+    bool Check(const std::string& name, size_t size, double value, double tolerance);
+
+    // Count of the failed checks of the run
+    size_t Failures();
+
+    // Writing the results as lines "name,size,ns" with a header. Returns false on error.
+    bool WriteResults(const std::string& path, const std::vector<Result>& results);
+
+    // Reading the results written by WriteResults. Returns false if the file can't be read.
+    bool ReadResults(const std::string& path, std::vector<Result>& results);
+
+    // Comparison of the results of the run with the baseline ones of the same names and sizes.
+    // A result slower than the baseline by more than the tolerance share is a regression.
+    // Returns the count of the regressions.
+    size_t CompareResults(const std::vector<Result>& baseline, double tolerance);
+
+    // Attributes of the targets of the game textures
+    sim::TargetDesc BombDesc();
+    sim::TargetDesc SuperBombDesc();
+
+    // Filling the world with count targets. The field grows with the count,
+    // so the density of the targets is the same as in the game with 20 targets on the 1024x768 screen.
+    void FillWorld(sim::World& world, size_t count);
+
+    // Count of repetitions of a benchmark to take about the given time, if one run took run_time seconds
+    int Repeats(double run_time, double budget);
+
+    // Benchmarks of the separate hot paths
+    void RunCollisions();
+    void RunMove();
+    void RunHits();
+    void RunBullets();
+    void RunPipeline();
+    void RunParallel();
+    void RunTrig();
+    void RunSpawn();
+    void RunWaves();
+    void RunDelete();
+    void RunRandom();
+    void RunConfig();
+}
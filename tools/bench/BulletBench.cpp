@@ -0,0 +1,150 @@
+/**
+ * \file
+ * \brief Benchmark of the movement of the bullets in flight
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Count of the integration steps of one run. The step is the bullet step of the game at 60 fps.
+        const int STEP_COUNT = 16;
+        const float STEP = 10.0f / 60.0f;
+
+        // Acceleration of gravity
+        const float G = 9.81f;
+
+        // Maximum relative difference of the batched and the reference integration caused by the order of the operations
+        const float MAX_ERROR = 1e-3f;
+
+        // Reference integration of one bullet with the arrays of the state as it was done per bullet
+        void RKFunc(const sim::Bullet& bullet, const float* xy_old, float* y)
+        {
+            y[0] = xy_old[1];
+            y[1] = -bullet.mCm * xy_old[1] - bullet.mKm * xy_old[3];
+            y[2] = xy_old[3];
+            y[3] = -G - bullet.mCm * xy_old[3] + bullet.mKm * xy_old[1];
+        }
+
+        void MoveReference(sim::Bullet& bullet, float dt)
+        {
+            float* xy_old = bullet.mXY;
+            if (xy_old[2] < -0.001f)
+            {
+                bullet.mIsUsed = true;
+                return;
+            }
+
+            float y1[sim::N_DIM];
+            float y2[sim::N_DIM];
+            float y3[sim::N_DIM];
+            float k1[sim::N_DIM];
+            float k2[sim::N_DIM];
+            float k3[sim::N_DIM];
+            float k4[sim::N_DIM];
+
+            RKFunc(bullet, xy_old, k1);
+            for (int i = 0; i < sim::N_DIM; i++)
+                y1[i] = xy_old[i] + 0.5f * dt * k1[i];
+
+            RKFunc(bullet, y1, k2);
+            for (int i = 0; i < sim::N_DIM; i++)
+                y2[i] = xy_old[i] + 0.5f * dt * k2[i];
+
+            RKFunc(bullet, y2, k3);
+            for (int i = 0; i < sim::N_DIM; i++)
+                y3[i] = xy_old[i] + dt * k3[i];
+
+            RKFunc(bullet, y3, k4);
+
+            for (int i = 0; i < sim::N_DIM; i++)
+                xy_old[i] += dt * (k1[i] + 2.0f * k2[i] + 2.0f * k3[i] + k4[i]) / 6.0f;
+        }
+
+        // Shots in random directions from random points of the field
+        void FireBullets(sim::BulletSystem& bullets, sim::Random& random, size_t count)
+        {
+            sim::BulletDesc desc = sim::MakePistolBullet(128.0f, 10);
+            for (size_t i = 0; i < count; i++)
+            {
+                sim::Vec2 point{ random.GetRealValue(0.0f, 1024.0f), random.GetRealValue(0.0f, 768.0f) };
+                bullets.Fire(static_cast<uint32_t>(i + 1), desc, point, random.GetRealValue(0.0f, 180.0f), random.GenIntValue(0, 1) == 1);
+            }
+        }
+
+        template <class Func>
+        double TimePerStep(Func func)
+        {
+            Stopwatch watch;
+            func();
+            int repeats = Repeats(watch.Seconds(), 0.3);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                func();
+            return watch.Seconds() / (repeats * STEP_COUNT);
+        }
+    }
+
+    void RunBullets()
+    {
+        const size_t counts[] = { 100, 1000, 10000 };
+
+        std::printf("%10s %14s %14s %10s %12s\n", "bullets", "batched, ns", "per bullet, ns", "speedup", "max error");
+        for (size_t count : counts)
+        {
+            sim::Random random(1);
+            sim::BulletSystem initial;
+            FireBullets(initial, random, count);
+
+            std::vector<sim::Bullet> reference(count);
+            for (size_t i = 0; i < count; i++)
+                reference[i] = initial.Get(i);
+
+            // Both versions start from the same state on each run
+            sim::BulletSystem batched;
+            double batched_time = TimePerStep([&]()
+            {
+                batched = initial;
+                for (int step = 0; step < STEP_COUNT; step++)
+                    batched.Integrate(STEP);
+            });
+
+            std::vector<sim::Bullet> moved;
+            double reference_time = TimePerStep([&]()
+            {
+                moved = reference;
+                for (int step = 0; step < STEP_COUNT; step++)
+                    for (auto& bullet : moved)
+                        MoveReference(bullet, STEP);
+            });
+
+            // Relative difference of the states after all steps
+            float max_error = 0.0f;
+            for (size_t i = 0; i < count; i++)
+            {
+                sim::Bullet state = batched.Get(i);
+                for (int j = 0; j < sim::N_DIM; j++)
+                {
+                    float scale = std::max(1.0f, std::fabs(moved[i].mXY[j]));
+                    max_error = std::max(max_error, std::fabs(state.mXY[j] - moved[i].mXY[j]) / scale);
+                }
+                if (state.mIsUsed != moved[i].mIsUsed)
+                    max_error = 1.0f;
+            }
+
+            std::printf("%10zu %14.2f %14.2f %10.2f %12.2e\n", count, batched_time * 1e9 / count,
+                        reference_time * 1e9 / count, reference_time / batched_time, max_error);
+            Report("bullets.integrate", count, batched_time);
+            Check("bullets.integrate", count, max_error, MAX_ERROR);
+        }
+    }
+}
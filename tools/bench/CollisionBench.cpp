@@ -0,0 +1,89 @@
+/**
+ * \file
+ * \brief Benchmark of the interaction of the targets with each other
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Maximum count of targets for the check of every pair
+        const size_t BRUTE_FORCE_LIMIT = 10000;
+
+        // Maximum difference of the velocities of both implementations caused by the order of the sums
+        const float MAX_DIFFERENCE = 1e-4f;
+
+        // Time step of the game at 60 FPS
+        const float TARGET_DT = sim::TARGET_TIME_SCALE / 60.0f;
+
+        template <class Func>
+        double TimePerTick(Func func)
+        {
+            Stopwatch watch;
+            func();
+            int repeats = Repeats(watch.Seconds(), 0.5);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                func();
+            return watch.Seconds() / repeats;
+        }
+
+        // Maximum difference of the velocities after one interaction pass of both implementations
+        float Difference(size_t count)
+        {
+            sim::World grid_world(1);
+            FillWorld(grid_world, count);
+            sim::World brute_world(1);
+            FillWorld(brute_world, count);
+
+            grid_world.Targets().CalcInteractions(TARGET_DT);
+            brute_world.Targets().CalcInteractionsBruteForce(TARGET_DT);
+
+            float diff = 0.0f;
+            auto& grid = grid_world.Targets();
+            auto& brute = brute_world.Targets();
+            for (size_t i = 0; i < grid.Size(); i++)
+            {
+                diff = std::max(diff, std::abs(grid.VelocityX()[i] - brute.VelocityX()[i]));
+                diff = std::max(diff, std::abs(grid.VelocityY()[i] - brute.VelocityY()[i]));
+            }
+            return diff;
+        }
+    }
+
+    void RunCollisions()
+    {
+        const size_t counts[] = { 20, 100, 1000, 10000, 100000 };
+
+        std::printf("%10s %14s %14s %14s %12s\n", "targets", "grid, us", "grid, ns/obj", "brute, us", "max dv");
+        for (size_t count : counts)
+        {
+            sim::World world(1);
+            FillWorld(world, count);
+            auto& targets = world.Targets();
+
+            double grid_time = TimePerTick([&targets]() { targets.CalcInteractions(TARGET_DT); });
+
+            double brute_time = 0.0;
+            float diff = 0.0f;
+            if (count <= BRUTE_FORCE_LIMIT)
+            {
+                brute_time = TimePerTick([&targets]() { targets.CalcInteractionsBruteForce(TARGET_DT); });
+                diff = Difference(count);
+                Check("collisions.grid", count, diff, MAX_DIFFERENCE);
+            }
+
+            std::printf("%10zu %14.2f %14.2f %14.2f %12.2e\n", count, grid_time * 1e6, grid_time * 1e9 / count,
+                        brute_time * 1e6, diff);
+            Report("collisions.grid", count, grid_time);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \brief Benchmark of the reading of the game parameters
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "sim/Config.h"
+
+namespace bench
+{
+    namespace
+    {
+        // input.txt with all parameters
+        const char* CONFIG_TEXT =
+            "Width=1024\nHeight=768\nCountTarget=20\nSpeed=128\nTime=50\nBulletCount=20\nTickRate=60\nMaxTicks=5\n"
+            "Waves=1\nWaveInterval=10\nEndless=0\nSpawnBudget=256\nMaxTargets=5000\nProfile=0\nTraceSeconds=10\n"
+            "Record=0\nRecordFile=session.rec\n";
+
+        // Count of the reads of the parameters in one run, as in a frame of the game
+        const size_t READ_COUNT = 1000;
+
+        template <class Func>
+        double TimePerRun(Func func)
+        {
+            Stopwatch watch;
+            func();
+            int repeats = Repeats(watch.Seconds(), 0.3);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                func();
+            return watch.Seconds() / repeats;
+        }
+    }
+
+    void RunConfig()
+    {
+        std::vector<std::string> errors;
+        sim::GameConfig config;
+        double parse_time = TimePerRun([&]() { sim::ParseConfig(CONFIG_TEXT, config, errors); });
+
+        // Reading as it was done before: the value is found by its name and converted from the string each time
+        std::map<std::string, std::string> params{ { "Width", "1024" }, { "Height", "768" }, { "Time", "50" } };
+        int sum = 0;
+        double map_time = TimePerRun([&]()
+        {
+            for (size_t i = 0; i < READ_COUNT; i++)
+            {
+                int value = 0;
+                std::istringstream(params["Time"]) >> value;
+                sum += value;
+            }
+        }) / READ_COUNT;
+
+        volatile const sim::GameConfig* typed = &config;
+        double typed_time = TimePerRun([&]()
+        {
+            for (size_t i = 0; i < READ_COUNT; i++)
+                sum += typed->mTime;
+        }) / READ_COUNT;
+
+        std::printf("%18s %12s\n", "version", "ns");
+        std::printf("%18s %12.2f\n", "parse input.txt", parse_time * 1e9);
+        std::printf("%18s %12.2f\n", "read by the name", map_time * 1e9);
+        std::printf("%18s %12.2f\n", "read the member", typed_time * 1e9);
+        Report("config.parse", 1, parse_time);
+        Report("config.read_map", READ_COUNT, map_time);
+        Report("config.read_typed", READ_COUNT, typed_time);
+
+        // The result is used, so the reading isn't removed by the compiler
+        if (sum == 1 && !errors.empty())
+            std::printf("\n");
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * \file
+ * \brief Benchmark of the removal of the dead targets and the used bullets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdio>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Killing every k-th target. The shot goes along the diagonal through the center of the target.
+        void KillTargets(sim::TargetSystem& targets, size_t k)
+        {
+            for (size_t i = 0; i < targets.Size(); i += k)
+                targets.CheckHit(sim::Vec2{ targets.X()[i], targets.Y()[i] }, 10, 1.0f, 1.0f, 1000000);
+        }
+
+        // Time of the removal of every k-th target from a copy of the world
+        double TimeDeleteDead(const sim::World& initial, size_t k)
+        {
+            int repeats = 0;
+            double time = 0.0;
+            while (time < 0.3 && repeats < 1000)
+            {
+                sim::TargetSystem targets = initial.Targets();
+                KillTargets(targets, k);
+                Stopwatch watch;
+                targets.DeleteDead();
+                time += watch.Seconds();
+                repeats++;
+            }
+            return time / repeats;
+        }
+
+        // Time of the removal of every k-th bullet
+        double TimeDeleteUsed(size_t count, size_t k)
+        {
+            sim::BulletDesc desc = sim::MakePistolBullet(128.0f, 10);
+            sim::BulletArray<sim::Bullet> retired;
+            int repeats = 0;
+            double time = 0.0;
+            while (time < 0.3 && repeats < 1000)
+            {
+                // The bullets fired under the ground become used on the integration
+                sim::BulletSystem bullets;
+                for (size_t i = 0; i < count; i++)
+                    bullets.Fire(static_cast<uint32_t>(i + 1), desc, sim::Vec2{ 100.0f, i % k == 0 ? -10.0f : 100.0f },
+                                 45.0f, false);
+                bullets.Integrate(0.0f);
+
+                retired.clear();
+                Stopwatch watch;
+                bullets.DeleteUsed(retired);
+                time += watch.Seconds();
+                repeats++;
+            }
+            return time / repeats;
+        }
+    }
+
+    void RunDelete()
+    {
+        const size_t counts[] = { 1000, 10000, 100000 };
+
+        std::printf("%10s %18s %18s\n", "objects", "dead targets, us", "used bullets, us");
+        for (size_t count : counts)
+        {
+            sim::World world(1);
+            FillWorld(world, count);
+
+            // A third of the objects is removed
+            double targets_time = TimeDeleteDead(world, 3);
+            double bullets_time = TimeDeleteUsed(count, 3);
+            std::printf("%10zu %18.2f %18.2f\n", count, targets_time * 1e6, bullets_time * 1e6);
+            Report("delete.targets", count, targets_time);
+            Report("delete.bullets", count, bullets_time);
+        }
+    }
+}
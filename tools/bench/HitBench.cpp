@@ -0,0 +1,116 @@
+/**
+ * \file
+ * \brief Benchmark of the hit check of the bullets with the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Count of bullets in flight
+        const size_t BULLET_COUNTS[] = { 20, 1000 };
+
+        // Maximum count of targets for the check of every target
+        const size_t LINEAR_LIMIT = 100000;
+
+        // Time step of the game at 60 FPS
+        const float TARGET_DT = sim::TARGET_TIME_SCALE / 60.0f;
+
+        struct Shot
+        {
+            sim::Vec2 mPoint;
+            float mVx;
+            float mVy;
+        };
+
+        std::vector<Shot> MakeShots(sim::World& world, size_t count)
+        {
+            auto& random = world.GetRandom();
+            auto& bounds = world.GetBounds();
+            std::vector<Shot> shots(count);
+            for (auto& shot : shots)
+            {
+                shot.mPoint = sim::Vec2{ random.GetRealValue(bounds.mMinX, bounds.mMaxX),
+                                         random.GetRealValue(bounds.mMinY, bounds.mMaxY) };
+                shot.mVx = random.GetRealValue(-128.0f, 128.0f);
+                shot.mVy = random.GetRealValue(-128.0f, 128.0f);
+            }
+            return shots;
+        }
+
+        // Time of the hit check of all shots. The grid is built by the interaction and the targets move
+        // before each run, so the checks use the grid of the previous positions as in a step of the game.
+        // Only the checks are measured.
+        template <class Func>
+        double TimePerTick(sim::World& world, Func func)
+        {
+            auto& targets = world.Targets();
+            auto tick = [&]()
+            {
+                targets.CalcInteractions(TARGET_DT);
+                targets.Move(TARGET_DT, world.GetBounds());
+                Stopwatch watch;
+                func();
+                return watch.Seconds();
+            };
+
+            // The count of the runs is limited by the time of the whole tick
+            Stopwatch watch;
+            tick();
+            int repeats = Repeats(watch.Seconds(), 0.3);
+            double seconds = 0.0;
+            for (int i = 0; i < repeats; i++)
+                seconds += tick();
+            return seconds / repeats;
+        }
+    }
+
+    void RunHits()
+    {
+        const size_t counts[] = { 20, 100, 1000, 10000, 100000 };
+
+        std::printf("%10s %10s %14s %14s %10s\n", "targets", "bullets", "grid, us", "linear, us", "mismatch");
+        for (size_t bullet_count : BULLET_COUNTS)
+            for (size_t count : counts)
+            {
+                sim::World world(1);
+                FillWorld(world, count);
+                auto shots = MakeShots(world, bullet_count);
+                auto& targets = world.Targets();
+
+                size_t grid_hits = 0;
+                double grid_time = TimePerTick(world, [&]()
+                {
+                    for (auto& shot : shots)
+                        grid_hits += targets.FindHit(shot.mPoint, 10, shot.mVx, shot.mVy) != sim::TargetSystem::NO_TARGET;
+                });
+
+                double linear_time = 0.0;
+                size_t mismatch = 0;
+                if (count <= LINEAR_LIMIT)
+                {
+                    linear_time = TimePerTick(world, [&]()
+                    {
+                        for (auto& shot : shots)
+                            grid_hits += targets.FindHitLinear(shot.mPoint, 10, shot.mVx, shot.mVy) != sim::TargetSystem::NO_TARGET;
+                    });
+
+                    for (auto& shot : shots)
+                        mismatch += targets.FindHit(shot.mPoint, 10, shot.mVx, shot.mVy) !=
+                                    targets.FindHitLinear(shot.mPoint, 10, shot.mVx, shot.mVy);
+                    // Both versions must find the same first target
+                    Check("hits.grid.bullets" + std::to_string(bullet_count), count, static_cast<double>(mismatch), 0.0);
+                }
+
+                std::printf("%10zu %10zu %14.2f %14.2f %10zu\n", count, bullet_count, grid_time * 1e6,
+                            linear_time * 1e6, mismatch);
+                Report("hits.grid.bullets" + std::to_string(bullet_count), count, grid_time);
+            }
+    }
+}
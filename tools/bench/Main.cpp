@@ -0,0 +1,132 @@
+/**
+ * \file
+ * \brief Benchmarks of the simulation hot paths
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* mName;
+        void (*mRun)();
+    };
+
+    const Benchmark BENCHMARKS[] =
+    {
+        { "collisions", bench::RunCollisions },
+        { "move", bench::RunMove },
+        { "hits", bench::RunHits },
+        { "bullets", bench::RunBullets },
+        { "pipeline", bench::RunPipeline },
+        { "parallel", bench::RunParallel },
+        { "trig", bench::RunTrig },
+        { "spawn", bench::RunSpawn },
+        { "waves", bench::RunWaves },
+        { "delete", bench::RunDelete },
+        { "random", bench::RunRandom },
+        { "config", bench::RunConfig },
+    };
+
+    // Share of the slowdown relative to the baseline that isn't a regression
+    const double DEFAULT_TOLERANCE = 0.3;
+
+    bool IsBenchmark(const std::string& name)
+    {
+        for (auto& benchmark : BENCHMARKS)
+        {
+            if (name == benchmark.mName)
+                return true;
+        }
+        return false;
+    }
+
+    int Usage()
+    {
+        std::fprintf(stderr, "Usage: war_bench [--csv results.csv] [--baseline baseline.csv] [--tolerance share] [name ...]\n"
+                             "Benchmarks:");
+        for (auto& benchmark : BENCHMARKS)
+            std::fprintf(stderr, " %s", benchmark.mName);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+}
+
+// Usage: war_bench [--csv results.csv] [--baseline baseline.csv] [--tolerance share] [name ...].
+// Without names all benchmarks are run, an unknown name or option is an error with the exit code 1. The results are written to the csv file and compared with the baseline;
+// the exit code is 3 if any of them is slower than the baseline by more than the tolerance (0.3 by default).
+// The exit code is 4 if a version gives results different from its reference one, e.g. the grid and the brute force collisions.
+int main(int argc, char* argv[])
+{
+    std::string csv_path;
+    std::string baseline_path;
+    double tolerance = DEFAULT_TOLERANCE;
+    std::vector<std::string> names;
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--csv") == 0 && has_value)
+            csv_path = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && has_value)
+            baseline_path = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && has_value)
+            tolerance = std::atof(argv[++i]);
+        else if (IsBenchmark(argv[i]))
+            names.push_back(argv[i]);
+        else
+        {
+            // A misspelled option or name would silently skip the check in a script
+            std::fprintf(stderr, "Unknown benchmark or option without its value: %s\n", argv[i]);
+            return Usage();
+        }
+    }
+
+    std::vector<bench::Result> baseline;
+    if (!baseline_path.empty() && !bench::ReadResults(baseline_path, baseline))
+    {
+        std::fprintf(stderr, "Can't read the baseline: %s\n", baseline_path.c_str());
+        return 2;
+    }
+
+    for (auto& benchmark : BENCHMARKS)
+    {
+        bool selected = names.empty() || std::find(names.begin(), names.end(), benchmark.mName) != names.end();
+        if (!selected)
+            continue;
+
+        std::printf("== %s\n", benchmark.mName);
+        benchmark.mRun();
+    }
+
+    if (!csv_path.empty() && !bench::WriteResults(csv_path, bench::Results()))
+    {
+        std::fprintf(stderr, "Can't write the results: %s\n", csv_path.c_str());
+        return 2;
+    }
+
+    size_t failures = bench::Failures();
+    if (failures > 0)
+        std::printf("%zu failed checks\n", failures);
+
+    size_t regressions = 0;
+    if (!baseline_path.empty())
+    {
+        std::printf("== baseline\n");
+        regressions = bench::CompareResults(baseline, tolerance);
+        std::printf("%zu regressions\n", regressions);
+    }
+
+    // The wrong results are worse than the slow ones
+    if (failures > 0)
+        return 4;
+    return regressions > 0 ? 3 : 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * \file
+ * \brief Benchmark of the movement of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "Bench.h"
+#include "sim/TargetKernels.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Time step of the game at 60 FPS
+        const float TARGET_DT = sim::TARGET_TIME_SCALE / 60.0f;
+
+        // Count of steps for the comparison of the results
+        const int CHECK_STEPS = 100;
+
+        double TimePerStep(sim::World& world, sim::SimdLevel level)
+        {
+            auto& targets = world.Targets();
+            targets.SetSimdLevel(level);
+
+            Stopwatch watch;
+            targets.Move(TARGET_DT, world.GetBounds());
+            int repeats = Repeats(watch.Seconds(), 0.3);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                targets.Move(TARGET_DT, world.GetBounds());
+            return watch.Seconds() / repeats;
+        }
+
+        // Maximum difference of the positions from the scalar movement after several steps
+        float Difference(size_t count, sim::SimdLevel level)
+        {
+            sim::World scalar_world(1);
+            FillWorld(scalar_world, count);
+            scalar_world.Targets().SetSimdLevel(sim::SimdLevel::SCALAR);
+            sim::World simd_world(1);
+            FillWorld(simd_world, count);
+            simd_world.Targets().SetSimdLevel(level);
+
+            for (int i = 0; i < CHECK_STEPS; i++)
+            {
+                scalar_world.Targets().Move(TARGET_DT, scalar_world.GetBounds());
+                simd_world.Targets().Move(TARGET_DT, simd_world.GetBounds());
+            }
+
+            float diff = 0.0f;
+            auto& scalar = scalar_world.Targets();
+            auto& simd = simd_world.Targets();
+            for (size_t i = 0; i < count; i++)
+            {
+                diff = std::max(diff, std::abs(scalar.X()[i] - simd.X()[i]));
+                diff = std::max(diff, std::abs(scalar.Y()[i] - simd.Y()[i]));
+            }
+            return diff;
+        }
+    }
+
+    void RunMove()
+    {
+        const size_t counts[] = { 20, 1000, 10000, 100000, 1000000 };
+        const sim::SimdLevel levels[] = { sim::SimdLevel::SCALAR, sim::SimdLevel::SSE2, sim::SimdLevel::AVX2 };
+
+        std::printf("detected: %s\n", sim::SimdName(sim::DetectSimd()));
+        std::printf("%10s %8s %14s %14s %10s %12s\n", "targets", "simd", "step, us", "ns/obj", "speedup", "max dx");
+        for (size_t count : counts)
+        {
+            double scalar_time = 0.0;
+            for (auto level : levels)
+            {
+                if (!sim::IsSimdBuilt(level) || (level == sim::SimdLevel::AVX2 && sim::DetectSimd() != level))
+                    continue;
+
+                sim::World world(1);
+                FillWorld(world, count);
+                double time = TimePerStep(world, level);
+                if (level == sim::SimdLevel::SCALAR)
+                    scalar_time = time;
+
+                std::printf("%10zu %8s %14.2f %14.2f %10.2f %12.2e\n", count, sim::SimdName(level), time * 1e6,
+                            time * 1e9 / count, scalar_time / time, Difference(std::min<size_t>(count, 10000), level));
+                Report(std::string("move.") + sim::SimdName(level), count, time);
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * \file
+ * \brief Benchmark of the parallel interaction of the targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "sim/ThreadPool.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Time step of the game at 60 FPS
+        const float TARGET_DT = sim::TARGET_TIME_SCALE / 60.0f;
+
+        // Maximum difference of the velocities of the serial and the parallel version caused by the order of the sums
+        const float MAX_DIFFERENCE = 1e-4f;
+
+        // Time of one interaction pass. The grid is rebuilt before each pass as once per tick in the game.
+        template <class Func>
+        double TimePerTick(sim::World& world, Func func)
+        {
+            auto tick = [&]()
+            {
+                world.Targets().Move(0.0f, world.GetBounds());
+                func();
+            };
+
+            Stopwatch watch;
+            tick();
+            int repeats = Repeats(watch.Seconds(), 0.5);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                tick();
+            return watch.Seconds() / repeats;
+        }
+
+        // Maximum difference of the velocities of two worlds with the same targets
+        float Difference(const sim::World& first, const sim::World& second)
+        {
+            auto& a = first.Targets();
+            auto& b = second.Targets();
+            float diff = 0.0f;
+            for (size_t i = 0; i < a.Size(); i++)
+            {
+                diff = std::max(diff, std::abs(a.VelocityX()[i] - b.VelocityX()[i]));
+                diff = std::max(diff, std::abs(a.VelocityY()[i] - b.VelocityY()[i]));
+            }
+            return diff;
+        }
+    }
+
+    void RunParallel()
+    {
+        const size_t counts[] = { 50000, 100000, 200000, 500000 };
+
+        std::vector<size_t> thread_counts;
+        size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+        for (size_t threads = 1; threads < max_threads; threads *= 2)
+            thread_counts.push_back(threads);
+        thread_counts.push_back(max_threads);
+
+        std::printf("%10s %10s %14s %10s %12s\n", "targets", "threads", "time, ms", "speedup", "max dv");
+        for (size_t count : counts)
+        {
+            sim::World serial(1);
+            FillWorld(serial, count);
+            double serial_time = TimePerTick(serial, [&]() { serial.Targets().CalcInteractions(TARGET_DT); });
+            std::printf("%10zu %10s %14.3f %10.2f %12s\n", count, "serial", serial_time * 1e3, 1.0, "-");
+            Report("parallel.serial", count, serial_time);
+
+            // One pass of each version from the same state for the comparison
+            sim::World reference(1);
+            FillWorld(reference, count);
+            reference.Targets().CalcInteractions(TARGET_DT);
+
+            for (size_t threads : thread_counts)
+            {
+                sim::ThreadPool pool(threads);
+
+                sim::World world(1);
+                FillWorld(world, count);
+                world.Targets().CalcInteractionsParallel(TARGET_DT, pool);
+                float diff = Difference(reference, world);
+                Check("parallel.threads" + std::to_string(threads), count, diff, MAX_DIFFERENCE);
+
+                double time = TimePerTick(world, [&]() { world.Targets().CalcInteractionsParallel(TARGET_DT, pool); });
+                std::printf("%10zu %10zu %14.3f %10.2f %12.2e\n", count, threads, time * 1e3, serial_time / time, diff);
+                Report("parallel.threads" + std::to_string(threads), count, time);
+            }
+        }
+    }
+}
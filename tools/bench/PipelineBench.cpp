@@ -0,0 +1,86 @@
+/**
+ * \file
+ * \brief Benchmark of the simulation on a separate thread
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+#include "sim/SimThread.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Count of the frames of one run
+        const int FRAME_COUNT = 120;
+        const float FRAME_DT = 1.0f / 60.0f;
+
+        // Work of the drawing thread: transforms of all targets of the frame
+        float Draw(const sim::Snapshot& state, std::vector<float>& matrices)
+        {
+            matrices.resize(state.TargetCount() * 4);
+            float sum = 0.0f;
+            for (size_t i = 0; i < state.TargetCount(); i++)
+            {
+                float x = state.mPrevX[i] + (state.mX[i] - state.mPrevX[i]) * state.mAlpha;
+                float y = state.mPrevY[i] + (state.mY[i] - state.mPrevY[i]) * state.mAlpha;
+                float angle = std::atan2(y, x);
+                matrices[i * 4] = std::cos(angle);
+                matrices[i * 4 + 1] = std::sin(angle);
+                matrices[i * 4 + 2] = x - state.mDeltaX[i];
+                matrices[i * 4 + 3] = y - state.mDeltaY[i];
+                sum += matrices[i * 4] + matrices[i * 4 + 3];
+            }
+            return sum;
+        }
+    }
+
+    void RunPipeline()
+    {
+        const size_t counts[] = { 1000, 10000, 50000 };
+
+        std::printf("%10s %12s %14s %10s\n", "targets", "serial, ms", "pipelined, ms", "speedup");
+        for (size_t count : counts)
+        {
+            std::vector<float> matrices;
+            float sum = 0.0f;
+
+            sim::World serial_world(1);
+            FillWorld(serial_world, count);
+            sim::Snapshot state;
+            Stopwatch watch;
+            for (int i = 0; i < FRAME_COUNT; i++)
+            {
+                serial_world.Update(FRAME_DT);
+                state.Capture(serial_world);
+                sum += Draw(state, matrices);
+            }
+            double serial_time = watch.Seconds() / FRAME_COUNT;
+
+            sim::World world(1);
+            FillWorld(world, count);
+            sim::SimThread sim(world);
+            sim.Flush();
+            watch.Restart();
+            for (int i = 0; i < FRAME_COUNT; i++)
+            {
+                sim.Frame(FRAME_DT);
+                sum += Draw(sim.Front(), matrices);
+            }
+            double pipelined_time = watch.Seconds() / FRAME_COUNT;
+
+            std::printf("%10zu %12.3f %14.3f %10.2f\n", count, serial_time * 1e3, pipelined_time * 1e3,
+                        serial_time / pipelined_time);
+            Report("pipeline.serial", count, serial_time);
+            Report("pipeline.pipelined", count, pipelined_time);
+
+            // The result is used, so the drawing isn't removed by the compiler
+            if (sum == 0.123f)
+                std::printf("\n");
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * \file
+ * \brief Benchmark of the random numbers
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Count of the numbers of one run
+        const size_t NUMBER_COUNT = 65536;
+
+        // Time of one run divided by the count of the numbers
+        template <class Func>
+        double TimePerNumber(Func func)
+        {
+            Stopwatch watch;
+            func();
+            int repeats = Repeats(watch.Seconds(), 0.3);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                func();
+            return watch.Seconds() / (repeats * NUMBER_COUNT);
+        }
+    }
+
+    void RunRandom()
+    {
+        sim::Random random(1);
+        std::mt19937 gen(1);
+        std::vector<float> values(NUMBER_COUNT);
+        std::vector<float> y(NUMBER_COUNT);
+        const sim::Bounds region{ 0.0f, 1024.0f, 0.0f, 768.0f };
+        int sum = 0;
+
+        // Generation as it was done before: a new distribution for each number
+        double reference_time = TimePerNumber([&]()
+        {
+            for (auto& value : values)
+            {
+                std::uniform_real_distribution<> urd(10.0f, 30.0f);
+                value = static_cast<float>(urd(gen));
+            }
+        });
+
+        double single_time = TimePerNumber([&]()
+        {
+            for (auto& value : values)
+                value = random.GetRealValue(10.0f, 30.0f);
+        });
+
+        double fill_time = TimePerNumber([&]() { random.FillReal(values.data(), NUMBER_COUNT, 10.0f, 30.0f); });
+        double points_time = TimePerNumber([&]() { random.FillPoints(values.data(), y.data(), NUMBER_COUNT, region); });
+        double int_time = TimePerNumber([&]()
+        {
+            for (size_t i = 0; i < NUMBER_COUNT; i++)
+                sum += random.GenIntValue(0, 99);
+        });
+
+        std::printf("%18s %12s\n", "version", "ns / number");
+        std::printf("%18s %12.2f\n", "mt19937, real", reference_time * 1e9);
+        std::printf("%18s %12.2f\n", "single real", single_time * 1e9);
+        std::printf("%18s %12.2f\n", "FillReal", fill_time * 1e9);
+        std::printf("%18s %12.2f\n", "FillPoints", points_time * 1e9);
+        std::printf("%18s %12.2f\n", "GenIntValue", int_time * 1e9);
+        Report("random.mt19937", NUMBER_COUNT, reference_time);
+        Report("random.real", NUMBER_COUNT, single_time);
+        Report("random.fill_real", NUMBER_COUNT, fill_time);
+        Report("random.fill_points", NUMBER_COUNT, points_time);
+        Report("random.int", NUMBER_COUNT, int_time);
+
+        // The result is used, so the generation isn't removed by the compiler
+        if (sum == 1 && values[0] == 0.123f)
+            std::printf("\n");
+    }
+}
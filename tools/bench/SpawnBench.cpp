@@ -0,0 +1,69 @@
+/**
+ * \file
+ * \brief Benchmark of the spawning of many targets
+ * \author Maksimovskiy A.S.
+ */
+
+#include <cstdio>
+#include <random>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Spawning as it was done before: the Mersenne twister and a new distribution for each number
+        void SpawnReference(sim::TargetSystem& targets, std::mt19937& gen, const sim::TargetDesc& desc,
+                            size_t count, const sim::Bounds& region)
+        {
+            auto real = [&gen](float min, float max)
+            {
+                std::uniform_real_distribution<> urd(min, max);
+                return static_cast<float>(urd(gen));
+            };
+
+            for (size_t i = 0; i < count; i++)
+            {
+                sim::Vec2 point{ real(region.mMinX, region.mMaxX), real(region.mMinY, region.mMaxY) };
+                std::uniform_int_distribution<> sign(0, 1);
+                float k = sign(gen) ? 1.0f : -1.0f;
+                sim::Vec2 velocity{ k * real(desc.mMinSpeed, desc.mMaxSpeed), k * real(desc.mMinSpeed, desc.mMaxSpeed) };
+                targets.Spawn(desc, point, velocity);
+            }
+        }
+    }
+
+    void RunSpawn()
+    {
+        const size_t counts[] = { 1000, 100000, 1000000 };
+        const sim::Bounds region{ 0.0f, 1024.0f, 0.0f, 768.0f };
+        const sim::TargetDesc desc = BombDesc();
+
+        std::printf("%10s %12s %14s %10s %14s\n", "targets", "batched, ms", "reference, ms", "speedup", "deterministic");
+        for (size_t count : counts)
+        {
+            sim::World world(1);
+            Stopwatch watch;
+            world.Init(region);
+            world.SpawnTargets(desc, static_cast<int>(count), region);
+            double batched_time = watch.Seconds();
+
+            // The same seed gives the same targets
+            sim::World other(1);
+            other.Init(region);
+            other.SpawnTargets(desc, static_cast<int>(count), region);
+            bool equal = other.Targets().X() == world.Targets().X() && other.Targets().VelocityY() == world.Targets().VelocityY();
+
+            sim::TargetSystem reference;
+            std::mt19937 gen(1);
+            watch.Restart();
+            SpawnReference(reference, gen, desc, count, region);
+            double reference_time = watch.Seconds();
+
+            std::printf("%10zu %12.2f %14.2f %10.2f %14s\n", count, batched_time * 1e3, reference_time * 1e3,
+                        reference_time / batched_time, equal ? "yes" : "no");
+            Report("spawn.batched", count, batched_time);
+        }
+    }
+}
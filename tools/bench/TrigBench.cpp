@@ -0,0 +1,99 @@
+/**
+ * \file
+ * \brief Benchmark of the table sine and cosine against the standard library
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+#include "sim/Trig.h"
+
+namespace bench
+{
+    namespace
+    {
+        // Count of the angles of one run
+        const size_t ANGLE_COUNT = 4096;
+
+        // Time of one run divided by the count of the angles
+        template <class Func>
+        double TimePerAngle(Func func)
+        {
+            Stopwatch watch;
+            func();
+            int repeats = Repeats(watch.Seconds(), 0.3);
+
+            watch.Restart();
+            for (int i = 0; i < repeats; i++)
+                func();
+            return watch.Seconds() / (repeats * ANGLE_COUNT);
+        }
+    }
+
+    void RunTrig()
+    {
+        // Angles of the shots and of the nonlinear movement: from a few turns back to a few turns forward
+        sim::Random random(1);
+        std::vector<float> angles(ANGLE_COUNT);
+        for (auto& angle : angles)
+            angle = random.GetRealValue(-20.0f, 20.0f);
+
+        std::vector<float> sin_values(ANGLE_COUNT);
+        std::vector<float> cos_values(ANGLE_COUNT);
+        std::vector<float> sin_reference(ANGLE_COUNT);
+        std::vector<float> cos_reference(ANGLE_COUNT);
+
+        double libm_time = TimePerAngle([&]()
+        {
+            for (size_t i = 0; i < ANGLE_COUNT; i++)
+            {
+                sin_reference[i] = std::sin(angles[i]);
+                cos_reference[i] = std::cos(angles[i]);
+            }
+        });
+
+        double batch_time = TimePerAngle([&]()
+        {
+            sim::SinCos(angles.data(), ANGLE_COUNT, sin_values.data(), cos_values.data());
+        });
+
+        float max_error = 0.0f;
+        for (size_t i = 0; i < ANGLE_COUNT; i++)
+        {
+            max_error = std::max(max_error, std::fabs(sin_values[i] - sin_reference[i]));
+            max_error = std::max(max_error, std::fabs(cos_values[i] - cos_reference[i]));
+        }
+
+        // One angle per call as in the gun and the bullets
+        double single_time = TimePerAngle([&]()
+        {
+            for (size_t i = 0; i < ANGLE_COUNT; i++)
+                sim::SinCos(angles[i], sin_values[i], cos_values[i]);
+        });
+
+        // Degrees with fractions as in the drawing of the bullets
+        float max_degree_error = 0.0f;
+        for (int i = -36000; i <= 36000; i++)
+        {
+            float degrees = i * 0.01f;
+            double radians = degrees * 3.14159265358979323846 / 180.0;
+            float sin_value, cos_value;
+            sim::SinCosDeg(degrees, sin_value, cos_value);
+            max_degree_error = std::max(max_degree_error, static_cast<float>(std::fabs(sin_value - std::sin(radians))));
+            max_degree_error = std::max(max_degree_error, static_cast<float>(std::fabs(cos_value - std::cos(radians))));
+        }
+
+        std::printf("%16s %12s %10s %12s\n", "version", "ns / angle", "speedup", "max error");
+        std::printf("%16s %12.2f %10.2f %12s\n", "std::sin, cos", libm_time * 1e9, 1.0, "-");
+        std::printf("%16s %12.2f %10.2f %12.2e\n", "table, batch", batch_time * 1e9, libm_time / batch_time, max_error);
+        std::printf("%16s %12.2f %10.2f %12.2e\n", "table, single", single_time * 1e9, libm_time / single_time, max_error);
+        std::printf("degrees with 0.01 step, max error: %.2e\n", max_degree_error);
+        Report("trig.libm", ANGLE_COUNT, libm_time);
+        Report("trig.batch", ANGLE_COUNT, batch_time);
+        Report("trig.single", ANGLE_COUNT, single_time);
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * \file
+ * \brief Benchmark of the spawning of the targets by waves
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Bench.h"
+
+namespace bench
+{
+    namespace
+    {
+        const float STEP = 1.0f / 60.0f;
+
+        sim::WavePlan MakePlan(const sim::Bounds& region, int count, int waves, int budget, int max_alive)
+        {
+            return sim::WavePlan{ { sim::WaveGroup{ SuperBombDesc(), std::min(count, 10) },
+                                    sim::WaveGroup{ BombDesc(), count - std::min(count, 10) } },
+                                  region, 1.0f, waves, budget, max_alive };
+        }
+
+        // Killing every k-th target, as the player does. Returns the count of the killed targets.
+        // The shot goes along the diagonal through the center of the target, so it always hits.
+        size_t KillTargets(sim::World& world, size_t k)
+        {
+            auto& targets = world.Targets();
+            size_t killed = 0;
+            for (size_t i = 0; i < targets.Size(); i += k)
+                killed += targets.CheckHit(sim::Vec2{ targets.X()[i], targets.Y()[i] }, 10, 1.0f, 1.0f, 1000000);
+            return killed;
+        }
+    }
+
+    void RunWaves()
+    {
+        const sim::Bounds region{ 0.0f, 4096.0f, 0.0f, 3072.0f };
+
+        // The step of the start of a large wave, when all its targets are spawned at once and by the budget
+        const int counts[] = { 5000, 20000, 100000 };
+        const int budget = 512;
+        std::printf("%10s %16s %16s %14s\n", "wave", "at once, ms", "budget, ms", "budget steps");
+        for (int count : counts)
+        {
+            sim::World at_once(1);
+            at_once.Init(region);
+            Stopwatch watch;
+            at_once.SpawnTargets(BombDesc(), count, region);
+            at_once.Step(STEP);
+            double at_once_time = watch.Seconds();
+
+            sim::World waves(1);
+            waves.Init(region);
+            waves.StartWaves(MakePlan(region, count, 1, budget, count));
+            watch.Restart();
+            waves.Step(STEP);
+            double waves_time = watch.Seconds();
+
+            int steps = 1;
+            while (!waves.Waves().Done())
+            {
+                waves.Step(STEP);
+                steps++;
+            }
+            std::printf("%10d %16.2f %16.2f %14d\n", count, at_once_time * 1e3, waves_time * 1e3, steps);
+            Report("waves.first_step", static_cast<size_t>(count), waves_time);
+        }
+
+        // The endless mode for an hour of the game with the targets killed all the time
+        const int hour_steps = 60 * 60 * 60;
+        const int max_alive = 200;
+        sim::World world(1);
+        world.Init(region);
+        world.StartWaves(MakePlan(region, 50, 0, 64, max_alive));
+        size_t capacity = world.Targets().X().capacity();
+        size_t max_size = 0;
+        size_t killed = 0;
+        Stopwatch watch;
+        for (int i = 0; i < hour_steps; i++)
+        {
+            if (i % 30 == 0)
+                killed += KillTargets(world, 3);
+            world.Step(STEP);
+            max_size = std::max(max_size, world.Targets().Size());
+        }
+
+        double hour_time = watch.Seconds();
+        std::printf("endless hour: %d waves, %zu killed, %.2f s, live targets at most %zu of %d, capacity %zu -> %zu\n",
+                    world.Waves().Wave(), killed, hour_time, max_size, max_alive, capacity,
+                    world.Targets().X().capacity());
+        Report("waves.endless_hour", static_cast<size_t>(max_alive), hour_time);
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * \file
+ * \brief Replay of the recorded sessions without drawing
+ * \author Maksimovskiy A.S.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#include "sim/TargetKernels.h"
+#include "sim/World.h"
+
+// Usage: war_replay session.rec. Returns 0 if the replayed final state is equal to the recorded one.
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "Usage: war_replay <session.rec>\n");
+        return 2;
+    }
+
+    sim::Replayer replayer;
+    if (!replayer.Load(argv[1]))
+    {
+        std::fprintf(stderr, "Can't read the session: %s\n", argv[1]);
+        return 2;
+    }
+
+    if (!sim::IsSimdSupported(replayer.Simd()))
+    {
+        std::fprintf(stderr, "The session was recorded with %s, which this processor doesn't support\n",
+                     sim::SimdName(replayer.Simd()));
+        return 2;
+    }
+
+    sim::World world(replayer.Seed());
+    auto start = std::chrono::steady_clock::now();
+    sim::ReplayResult result = replayer.Run(world);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("updates: %zu\nsteps: %zu\ntime: %.3f s\nsteps per second: %.0f\n", result.mUpdates,
+                result.mSteps, seconds, seconds > 0.0 ? result.mSteps / seconds : 0.0);
+    std::printf("final state: %016" PRIx64 "\n", result.mHash);
+
+    if (!result.mComplete)
+    {
+        std::fprintf(stderr, "The session is damaged\n");
+        return 1;
+    }
+
+    if (!result.mHasExpectedHash)
+    {
+        std::printf("The session isn't finished, the final state isn't checked\n");
+        return 0;
+    }
+
+    bool equal = result.mHash == result.mExpectedHash;
+    std::printf("recorded state: %016" PRIx64 " (%s)\n", result.mExpectedHash, equal ? "equal" : "different");
+    return equal ? 0 : 1;
+}
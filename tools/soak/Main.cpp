@@ -0,0 +1,392 @@
+/**
+ * \file
+ * \brief Long run of the simulation with a synthetic player to find slow steps and the growth of the memory
+ * \author Maksimovskiy A.S.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "sim/Archetypes.h"
+#include "sim/Atlas.h"
+#include "sim/Config.h"
+#include "sim/Memory.h"
+#include "sim/Snapshot.h"
+#include "sim/Trig.h"
+#include "sim/World.h"
+
+namespace
+{
+    // Size of the texture of a target which isn't found in the atlas table
+    const int DEFAULT_TEXTURE_SIZE = 64;
+    // Share of the run before the memory is considered warmed up
+    const double WARM_UP_SHARE = 0.25;
+    // Count of the samples of the memory after the warm-up needed for its trend
+    const size_t MIN_TREND_SAMPLES = 3;
+    // Angles of the gun in the bottom left corner swept by the player in degrees
+    const float MIN_ANGLE = 20.0f;
+    const float MAX_ANGLE = 85.0f;
+
+    struct Options
+    {
+        std::string mConfig = "bin/base_p/input.txt";
+        std::string mTargets = "bin/base_p/Targets.xml";
+        std::string mAtlas = "bin/base_p/textures/atlas.txt";
+
+        // Simulated time of the run in seconds
+        double mSeconds = 3600.0;
+        // Shots per second
+        float mFireRate = 10.0f;
+        // Period of printing of the counts in simulated seconds
+        double mSample = 60.0;
+
+        // Overrides of CountTarget, BulletCount and Threads of the config, -1 to keep them
+        int mCountTarget = -1;
+        int mBulletCount = -1;
+        int mThreads = -1;
+
+        // Limits of the run: the p99 of the step time in milliseconds, the growth of the memory
+        // and the count of the steps allocating memory of the subsystems after the warm-up
+        double mP99Budget = 4.0;
+        long long mMaxGrowthKb = 2048;
+        long long mMaxAllocSteps = 0;
+    };
+
+    bool ReadFile(const std::string& path, std::string& text)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        text = buffer.str();
+        return true;
+    }
+
+    // Resident memory of the process in kilobytes, 0 if it is unknown
+    long long ResidentKb()
+    {
+#if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        long long pages = 0;
+        long long resident = 0;
+        if (statm >> pages >> resident)
+            return resident * sysconf(_SC_PAGESIZE) / 1024;
+#endif
+        return 0;
+    }
+
+    // Peak of the resident memory of the process in kilobytes, 0 if it is unknown
+    long long PeakResidentKb()
+    {
+#if defined(__linux__)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return usage.ru_maxrss;
+#endif
+        return 0;
+    }
+
+    // Growth of the memory over the steps of the samples by the least squares line through them.
+    // A single trim of the allocator changes the line a little, unlike the difference of two samples.
+    double TrendKb(const std::vector<long long>& samples_kb, const std::vector<size_t>& sample_steps, size_t first)
+    {
+        double count = static_cast<double>(samples_kb.size() - first);
+        double mean_step = 0.0;
+        double mean_kb = 0.0;
+        for (size_t i = first; i < samples_kb.size(); i++)
+        {
+            mean_step += sample_steps[i] / count;
+            mean_kb += samples_kb[i] / count;
+        }
+
+        double covariance = 0.0;
+        double variance = 0.0;
+        for (size_t i = first; i < samples_kb.size(); i++)
+        {
+            double step = sample_steps[i] - mean_step;
+            covariance += step * (samples_kb[i] - mean_kb);
+            variance += step * step;
+        }
+        if (variance <= 0.0)
+            return 0.0;
+
+        double slope = covariance / variance;
+        return slope * (sample_steps.back() - sample_steps[first]);
+    }
+
+    double Percentile(std::vector<float> values, double share)
+    {
+        if (values.empty())
+            return 0.0;
+
+        size_t index = std::min(values.size() - 1, static_cast<size_t>(share * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            if (i + 1 >= argc)
+                return false;
+
+            std::string name = argv[i];
+            const char* value = argv[++i];
+            if (name == "--config")
+                options.mConfig = value;
+            else if (name == "--targets-xml")
+                options.mTargets = value;
+            else if (name == "--atlas")
+                options.mAtlas = value;
+            else if (name == "--seconds")
+                options.mSeconds = std::atof(value);
+            else if (name == "--fire-rate")
+                options.mFireRate = static_cast<float>(std::atof(value));
+            else if (name == "--sample")
+                options.mSample = std::atof(value);
+            else if (name == "--targets")
+                options.mCountTarget = std::atoi(value);
+            else if (name == "--bullets")
+                options.mBulletCount = std::atoi(value);
+            else if (name == "--threads")
+                options.mThreads = std::atoi(value);
+            else if (name == "--p99-ms")
+                options.mP99Budget = std::atof(value);
+            else if (name == "--max-growth-kb")
+                options.mMaxGrowthKb = std::atoll(value);
+            else if (name == "--max-alloc-steps")
+                options.mMaxAllocSteps = std::atoll(value);
+            else
+                return false;
+        }
+        return options.mSeconds > 0.0 && options.mSample > 0.0 && options.mFireRate >= 0.0f && options.mThreads != 0;
+    }
+
+    // Wave plan of the endless mode from the config and the kinds of the targets.
+    // The sizes of the targets are taken from the atlas table, as the game takes them from the textures.
+    bool MakePlan(const Options& options, const sim::GameConfig& config, const sim::Bounds& region, sim::WavePlan& plan)
+    {
+        std::string xml;
+        std::vector<sim::TargetArchetype> archetypes;
+        std::vector<std::string> errors;
+        if (!ReadFile(options.mTargets, xml) || !sim::ParseArchetypes(xml, archetypes, errors))
+        {
+            std::fprintf(stderr, "Can't read the targets: %s\n", options.mTargets.c_str());
+            for (auto& error : errors)
+                std::fprintf(stderr, "  %s\n", error.c_str());
+            return false;
+        }
+
+        std::string table_text;
+        sim::AtlasTable table;
+        bool has_table = ReadFile(options.mAtlas, table_text) && sim::ParseAtlasTable(table_text, table);
+
+        plan = sim::WavePlan{ {}, region, config.mWaveInterval, 0, config.mSpawnBudget, config.mMaxTargets };
+        std::vector<int> counts = sim::SplitTargetCount(archetypes, config.mCountTarget);
+        for (size_t i = 0; i < archetypes.size(); i++)
+        {
+            const sim::AtlasRegion* image = has_table ? table.Find(archetypes[i].mTexture) : nullptr;
+            int width = image ? image->mWidth : DEFAULT_TEXTURE_SIZE;
+            int height = image ? image->mHeight : DEFAULT_TEXTURE_SIZE;
+            plan.mGroups.push_back(sim::WaveGroup{ sim::MakeTargetDesc(archetypes[i], i, width, height), counts[i] });
+        }
+        return true;
+    }
+}
+
+// Usage: war_soak [--seconds 3600] [--targets N] [--bullets N] [--threads N] [--fire-rate 10] [--sample 60]
+//                 [--p99-ms 4] [--max-growth-kb 2048] [--max-alloc-steps 0]
+//                 [--config input.txt] [--targets-xml Targets.xml] [--atlas atlas.txt]
+// The targets come in endless waves, the player sweeps the gun and fires while there are bullets in the magazine.
+// Returns 1 if the p99 of the step time is over the budget, the memory keeps growing
+// or the steps still allocate memory of the subsystems after the warm-up.
+// Returns 2 on wrong options or if the run is too short to have samples of the memory after the warm-up.
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::fprintf(stderr, "Usage: war_soak [--seconds s] [--targets n] [--bullets n] [--threads n] [--fire-rate n] [--sample s] "
+                             "[--p99-ms ms] [--max-growth-kb kb] [--max-alloc-steps n] [--config path] [--targets-xml path] "
+                             "[--atlas path]\n");
+        return 2;
+    }
+
+    sim::GameConfig config;
+    std::string config_text;
+    std::vector<std::string> errors;
+    std::vector<std::string> unknown;
+    // The config is read as the game reads it on the start
+    if (ReadFile(options.mConfig, config_text) && !sim::ParseConfig(config_text, config, errors, &unknown))
+    {
+        std::fprintf(stderr, "Wrong config %s: %s\n", options.mConfig.c_str(), errors.front().c_str());
+        return 2;
+    }
+    for (auto& name : unknown)
+        std::fprintf(stderr, "Unknown parameter of %s is ignored: %s\n", options.mConfig.c_str(), name.c_str());
+    if (options.mCountTarget >= 0)
+        config.mCountTarget = options.mCountTarget;
+    if (options.mBulletCount >= 0)
+        config.mBulletCount = options.mBulletCount;
+    if (options.mThreads > 0)
+        config.mThreads = options.mThreads;
+
+    // The same field as in the game with the gun in the bottom left corner
+    const sim::Bounds bounds{ 0.0f, static_cast<float>(config.mWidth), 0.0f, static_cast<float>(config.mHeight) };
+    const sim::Bounds region{ 0.0f, config.mWidth * 0.7f, 0.0f, config.mHeight * 0.7f };
+    sim::WavePlan plan;
+    if (!MakePlan(options, config, region, plan))
+        return 2;
+
+    sim::World world(1);
+    world.SetThreadCount(static_cast<size_t>(config.mThreads));
+    world.Init(bounds);
+    world.StartWaves(plan);
+    world.ReserveBullets(static_cast<size_t>(config.mBulletCount));
+    sim::Snapshot snapshot;
+
+    const float dt = 1.0f / config.mTickRate;
+    const size_t steps = static_cast<size_t>(options.mSeconds * config.mTickRate);
+    const size_t sample_steps = std::max<size_t>(1, static_cast<size_t>(options.mSample * config.mTickRate));
+    // The memory after the first step is the reference even in the shortest run
+    const size_t warm_up_steps = std::max<size_t>(1, static_cast<size_t>(steps * WARM_UP_SHARE));
+    const sim::BulletDesc bullet = sim::MakePistolBullet(config.mSpeed, 10);
+
+    // Samples are taken after the steps multiple of sample_steps, the trend uses the ones after the warm-up
+    const size_t sample_total = steps / sample_steps;
+    const size_t trend_first = std::min(sample_total, (warm_up_steps - 1) / sample_steps);
+    if (sample_total - trend_first < MIN_TREND_SAMPLES)
+    {
+        std::fprintf(stderr, "The run is too short for the check of the memory: %zu samples after the warm-up, "
+                             "at least %zu are needed. Increase --seconds or decrease --sample.\n",
+                     sample_total - trend_first, MIN_TREND_SAMPLES);
+        return 2;
+    }
+
+    // The memory of the measurements is filled before the run, so its pages don't count as growth
+    std::vector<float> step_ms(steps, 0.0f);
+    std::vector<long long> samples_kb(sample_total, 0);
+    std::vector<size_t> samples_step(sample_total, 0);
+    size_t sample_count = 0;
+
+    float shot_time = 0.0f;
+    float angle_phase = 0.0f;
+    size_t shots = 0;
+    long long warm_up_kb = 0;
+    // Steps allocating memory of the subsystems after the warm-up
+    auto& memory = sim::MemoryTracker::Instance();
+    long long alloc_steps = 0;
+
+    std::printf("%10s %10s %10s %10s %12s %12s\n", "time, s", "targets", "bullets", "wave", "shots", "rss, KB");
+    for (size_t step = 0; step < steps; step++)
+    {
+        // The player fires at the fire rate while the count of the bullets in flight is less than the magazine.
+        // The angle of the gun goes back and forth through the field.
+        shot_time += dt;
+        angle_phase += dt;
+        while (options.mFireRate > 0.0f && shot_time >= 1.0f / options.mFireRate)
+        {
+            shot_time -= 1.0f / options.mFireRate;
+            if (world.Bullets().Size() >= static_cast<size_t>(config.mBulletCount))
+                continue;
+
+            float sweep = 0.5f + 0.5f * sim::SinDeg(angle_phase * 20.0f);
+            world.Fire(bullet, sim::Vec2{ 60.0f, 40.0f }, MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * sweep, false);
+            shots++;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        world.Step(dt);
+        snapshot.Capture(world);
+        step_ms[step] = static_cast<float>(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        memory.FrameMark();
+        if (step >= warm_up_steps && memory.FrameAllocs() > 0)
+            alloc_steps++;
+
+        if (step + 1 == warm_up_steps)
+            warm_up_kb = ResidentKb();
+
+        if ((step + 1) % sample_steps == 0)
+        {
+            long long rss = ResidentKb();
+            samples_step[sample_count] = step + 1;
+            samples_kb[sample_count++] = rss;
+            std::printf("%10.0f %10zu %10zu %10d %12zu %12lld\n", (step + 1) * dt, world.Targets().Size(),
+                        world.Bullets().Size(), world.Waves().Wave(), shots, rss);
+            // The samples of a long run are seen while it goes
+            std::fflush(stdout);
+        }
+    }
+
+    long long final_kb = ResidentKb();
+    // The size of the resident memory is unknown on some systems
+    long long growth_kb = warm_up_kb > 0 ? static_cast<long long>(TrendKb(samples_kb, samples_step, trend_first)) : 0;
+
+    // The steady state is the average of the samples after the warm-up
+    long long steady_kb = 0;
+    size_t steady_count = 0;
+    for (size_t i = samples_kb.size() / 4; i < samples_kb.size(); i++, steady_count++)
+        steady_kb += samples_kb[i];
+    steady_kb = steady_count > 0 ? steady_kb / static_cast<long long>(steady_count) : final_kb;
+
+    double p50 = Percentile(step_ms, 0.5);
+    double p99 = Percentile(step_ms, 0.99);
+    double p999 = Percentile(step_ms, 0.999);
+    double max_ms = step_ms.empty() ? 0.0 : *std::max_element(step_ms.begin(), step_ms.end());
+    std::printf("threads: %zu\n", world.ThreadCount());
+    std::printf("steps: %zu, step ms p50 %.3f, p99 %.3f, p99.9 %.3f, max %.3f\n", steps, p50, p99, p999, max_ms);
+    // The peak of the system is counted in its own way, so the samples are taken into account too
+    long long peak_kb = std::max(PeakResidentKb(), final_kb);
+    for (long long sample : samples_kb)
+        peak_kb = std::max(peak_kb, sample);
+    std::printf("rss KB: peak %lld, steady %lld, after the warm-up %lld, final %lld, trend after the warm-up %lld\n",
+                peak_kb, steady_kb, warm_up_kb, final_kb, growth_kb);
+
+    for (size_t i = 0; i < sim::MEM_TAG_COUNT; i++)
+    {
+        sim::MemTag tag = static_cast<sim::MemTag>(i);
+        sim::MemoryStats stats = memory.Stats(tag);
+        if (stats.mAllocs > 0)
+            std::printf("%s: live %zu KB, peak %zu KB, allocs %llu, max per step %llu\n", sim::MemTagName(tag),
+                        stats.mLive / 1024, stats.mPeak / 1024, static_cast<unsigned long long>(stats.mAllocs),
+                        static_cast<unsigned long long>(stats.mMaxFrameAllocs));
+    }
+    std::printf("steps with allocations after the warm-up: %lld\n", alloc_steps);
+
+    bool failed = false;
+    if (p99 > options.mP99Budget)
+    {
+        std::printf("FAIL: p99 of the step %.3f ms is over the budget %.3f ms\n", p99, options.mP99Budget);
+        failed = true;
+    }
+    if (growth_kb > options.mMaxGrowthKb)
+    {
+        std::printf("FAIL: the trend of the memory has grown by %lld KB after the warm-up, the limit is %lld KB\n", growth_kb,
+                    options.mMaxGrowthKb);
+        failed = true;
+    }
+    if (alloc_steps > options.mMaxAllocSteps)
+    {
+        std::printf("FAIL: %lld steps have allocated memory after the warm-up, the limit is %lld\n", alloc_steps,
+                    options.mMaxAllocSteps);
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}